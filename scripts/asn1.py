@@ -19,6 +19,8 @@ Arguments:
                    - "safrole"         : Generates safrole module types.
                    - "disputes"        : Generates dispute module types.
                    - "authorizations"  : Generates authorization module types.
+                   - "codec_bench"     : Generates codec benchmark of all types;
+                                         following arguments are enabled modules.
 
 Requirements:
     - Python 3
@@ -34,11 +36,17 @@ Notes:
     - The script enforces that <output_path> must be inside the project directory.
     - It parses ASN.1 files located in predefined subdirectories.
     - The generated C++ files include type declarations, enums, and diff functions.
+    - Common types also get views (common-views.hpp), which borrow fixed-size
+      byte fields from decoded buffer instead of copying them.
+    - For each constant set (tiny, full) types specialized at compile time are
+      generated (<name>-types-<set>.hpp), where config-sized sequences are
+      `std::array`. Config is still passed on decoding, for `jam::Hashed`.
 
 """
 
 import asn1tools
 import os.path
+import re
 import sys
 
 DIR = os.path.abspath(os.path.dirname(__file__))
@@ -73,6 +81,38 @@ def c_struct(name: str, members):
     ]
 
 
+# Members which are stored along with hash of their encoding, to avoid
+# re-encoding and re-hashing them on each access
+HASHED_MEMBERS = {
+    "AvailabilityAssignment": {"report"},
+}
+
+
+# Constant sets, for each of them types with compile-time sizes are generated
+CONSTANT_SETS = ["tiny", "full"]
+
+
+# Bounded sequences which are stored in fixed-capacity inline ring buffer,
+# capacity is the largest bound among all constant sets
+RING_BUFFERS = {
+    "AuthPool",
+    "BlocksHistory",
+}
+
+
+# Immutable values shared by all equal instances, e.g. validator sets which
+# appear several times in state and are rotated on epoch change
+INTERNED = {
+    "ValidatorsData",
+}
+
+
+def c_hashed(tname: str, name: str, r: str):
+    if name in HASHED_MEMBERS.get(tname, ()):
+        return "::jam::Hashed<%s>" % r
+    return r
+
+
 def c_dash(s: int | str):
     if isinstance(s, int):
         return s
@@ -176,7 +216,47 @@ def c_fittest_int_type(min_value: int, max_value: int):
     return None
 
 
-def parse_types(cpp_namespace: str, ARGS: list[str], path: str, key: str, imports: list[str] = []):
+def asn_fixed_bytes(t: dict):
+    if t["type"] == "OCTET STRING":
+        return "size" in t
+    if t["type"] == "SEQUENCE OF" and t["element"]["type"] == "U8":
+        (size,) = t.get("size", (None,))
+        return isinstance(size, (int, str))
+    return False
+
+
+def asn_config_sized(t: dict):
+    if t["type"] not in ("OCTET STRING", "SEQUENCE OF"):
+        return False
+    (size,) = t.get("size", (None,))
+    return isinstance(size, str)
+
+
+class Derived:
+    """
+    Variant of types, generated in addition to owning runtime-config ones.
+    Types which are not affected by variant are aliases of owning ones.
+    """
+
+    def __init__(self, base: str, view: bool = False, constants: str | None = None):
+        # Namespace of owning types
+        self.base = base
+        # Fixed-size byte fields are borrowed from decoded buffer
+        # (see `jam::decode_borrowed`)
+        self.view = view
+        # Namespace of constant set, config-sized sequences are `std::array`
+        self.constants = constants
+
+    def affects(self, t: dict):
+        if self.view and asn_fixed_bytes(t):
+            return True
+        if self.constants and asn_config_sized(t):
+            return True
+        return False
+
+
+def parse_types(cpp_namespace: str, ARGS: list[str], path: str, key: str, imports: list[str] = [],
+                derived: Derived | None = None):
     def asn_sequence_of(t):
         (size,) = t.get("size", (None,))
         fixed = isinstance(size, (int, str))
@@ -185,16 +265,35 @@ def parse_types(cpp_namespace: str, ARGS: list[str], path: str, key: str, import
         if T == "U8":
             if fixed:
                 if type(size) is int:
+                    if derived and derived.view:
+                        return "::jam::ByteArrView<%u>" % size
                     return "qtils::ByteArr<%u>" % size
                 else:
+                    if derived and derived.constants:
+                        if derived.view:
+                            return "::jam::ByteArrView<%s::%s>" % (derived.constants, c_dash(size))
+                        return "qtils::ByteArr<%s::%s>" % (derived.constants, c_dash(size))
+                    if derived and derived.view:
+                        return "::jam::ConfigByteView<Config::Field::%s>" % c_dash(size)
                     return "::jam::ConfigVec<uint8_t, Config::Field::%s>" % c_dash(size)
             return "qtils::ByteVec"
         if fixed:
             if isinstance(size, str):
+                if derived and derived.constants:
+                    return "std::array<%s, %s::%s>" % (T, derived.constants, c_dash(size))
                 return "::jam::ConfigVec<%s, Config::Field::%s>" % (T, c_dash(size))
             return "std::array<%s, %s>" % (T, c_dash(size))
         return "std::vector<%s>" % T
 
+    def asn_ring_buffer(t):
+        ((_, bound),) = t["size"]
+        T = t["element"]["type"]
+        assert T in types
+        if isinstance(bound, int):
+            return "::jam::RingBuffer<%s, %d>" % (T, bound)
+        bound = c_dash(bound)
+        return "::jam::RingBuffer<%s, std::max(constants::tiny::%s, constants::full::%s)>" % (T, bound, bound)
+
     def asn_member(t):
         if t["type"] == "INTEGER":
             int_type = c_fittest_int_type(*t["restricted-to"][0])
@@ -232,9 +331,20 @@ def parse_types(cpp_namespace: str, ARGS: list[str], path: str, key: str, import
     for tname, args in asn_args(ARGS, asn_types, deps2).items():
         types[tname].args = args
 
+    if derived:
+        # Imported types are considered affected, as their variants are imported
+        affected = {
+            k: any(derived.affects(x) or x["type"] in imports for x in asn_recurse(t))
+            for k, t in asn_types.items()
+        }
+        affected = {k: a or any(affected[d] for d in deps1[k]) for k, a in affected.items()}
+
     enum_trait = []
     for tname, t in asn_types.items():
         ty = types[tname]
+        if derived and not affected[tname]:
+            ty.decl = c_using(tname, "%s::%s" % (derived.base, tname))
+            continue
         if t["type"] == "CHOICE":
             if [x["name"] for x in t["members"]] == ["none", "some"]:
                 if [x["tag"]["number"] for x in t["members"]] == [0, 1]:
@@ -292,7 +402,9 @@ def parse_types(cpp_namespace: str, ARGS: list[str], path: str, key: str, import
             continue
         if t["type"] == "SEQUENCE":
             ty.decl = c_struct(
-                tname, [(c_dash(x["name"]), asn_member(x)) for x in t["members"]]
+                tname,
+                [(c_dash(x["name"]), asn_member(x) if derived and derived.view else c_hashed(tname, x["name"], asn_member(x)))
+                 for x in t["members"]]
             )
             ty.diff = c_diff(
                 cpp_namespace, ty, ["DIFF_M(%s);" % c_dash(x["name"]) for x in t["members"]]
@@ -301,6 +413,12 @@ def parse_types(cpp_namespace: str, ARGS: list[str], path: str, key: str, import
         if t["type"] == "NULL":
             ty.decl = c_using(tname, "qtils::Empty");
             continue
+        if tname in RING_BUFFERS and not (derived and derived.view):
+            ty.decl = c_using(tname, asn_ring_buffer(t))
+            continue
+        if tname in INTERNED and not (derived and derived.view):
+            ty.decl = c_using(tname, "::jam::Interned<%s>" % asn_member(t))
+            continue
         ty.decl = c_using(tname, asn_member(t))
 
     order = asn1tools.c.utils.topological_sort(deps1)
@@ -340,6 +458,7 @@ class GenConstants:
             *["      struct %s {};" % const_name for const_name in constant_names],
             "    };",
             *["    uint32_t %s;" % const_name for const_name in constant_names],
+            "    bool operator==(const Config &) const = default;",
             *[
                 "    auto get(Field::%s) const { return %s; }"
                 % (const_name, const_name)
@@ -407,6 +526,7 @@ class GenCommonTypes:
             "",
             "#pragma once",
             "",
+            "#include <algorithm>",
             "#include <array>",
             "#include <optional>",
             "#include <string_view>",
@@ -418,7 +538,12 @@ class GenCommonTypes:
             "#include <qtils/tagged.hpp>",
             "",
             "#include <jam_types/config.hpp>",
+            "#include <jam_types/constants-full.hpp>",
+            "#include <jam_types/constants-tiny.hpp>",
             "#include <test-vectors/config-types.hpp>",
+            "#include <test-vectors/hashed.hpp>",
+            "#include <test-vectors/interned.hpp>",
+            "#include <test-vectors/ring-buffer.hpp>",
             "",
             *self.g_types,
         ]
@@ -434,10 +559,48 @@ class GenCommonTypes:
             *self.g_diff,
         ]
 
+        view_types, _ = parse_types("%s::view" % cpp_namespace, [], asn_file("%s/jam-types" % path), "JamTypes",
+                                    derived=Derived("::%s" % cpp_namespace, view=True))
+        self.g_views = flatten([*ty.c_tdecl(), *ty.decl] for ty in view_types)
+        self.g_views = ["namespace %s::view {" % cpp_namespace, *indent(self.g_views), "}"]
+        self.g_views = [
+            "// Auto-generated file",
+            "",
+            "#pragma once",
+            "",
+            "#include <jam_types/common-types.hpp>",
+            "#include <test-vectors/byte-view.hpp>",
+            "",
+            *self.g_views,
+        ]
+
+        self.g_specialized = dict()
+        for set_name in CONSTANT_SETS:
+            ns = "%s::%s" % (cpp_namespace, set_name)
+            specialized_types, _ = parse_types(ns, [], asn_file("%s/jam-types" % path), "JamTypes",
+                                               derived=Derived("::%s" % cpp_namespace,
+                                                               constants="::%s::constants::%s" % (
+                                                                   cpp_namespace, set_name)))
+            g = flatten([*ty.c_tdecl(), *ty.decl] for ty in specialized_types)
+            self.g_specialized[set_name] = [
+                "// Auto-generated file",
+                "",
+                "#pragma once",
+                "",
+                "#include <jam_types/common-types.hpp>",
+                "",
+                "namespace %s {" % ns,
+                *indent(g),
+                "}",
+            ]
+
     def write(self):
         prefix = os.path.join(OUTPUT_DIR)
         write(prefix + "/common-types.hpp", self.g_types)
         write(prefix + "/common-diff.hpp", self.g_diff)
+        write(prefix + "/common-views.hpp", self.g_views)
+        for set_name, content in self.g_specialized.items():
+            write(prefix + "/common-types-%s.hpp" % set_name, content)
 
 
 class GenSpecialTypes:
@@ -474,6 +637,7 @@ class GenSpecialTypes:
             "",
             *includes,
             "#include <test-vectors/config-types.hpp>",
+            "#include <test-vectors/ring-buffer.hpp>",
             "",
             *self.g_types,
         ]
@@ -491,10 +655,96 @@ class GenSpecialTypes:
             *self.g_diff,
         ]
 
+        self.g_specialized = dict()
+        for set_name in CONSTANT_SETS:
+            ns = "%s::%s" % (cpp_namespace, set_name)
+            usings = []
+            for module_name, importing_types in asn_imports.items():
+                match module_name:
+                    case 'JamTypes':
+                        usings += ["using ::%s::%s;" % (ns, t) for t in importing_types]
+            specialized_types, _ = parse_types("%s::%s" % (ns, name), [], self.asn_file, module,
+                                               flatten(asn_imports.values()),
+                                               derived=Derived("::%s::%s" % (cpp_namespace, name),
+                                                               constants="::%s::constants::%s" % (
+                                                                   cpp_namespace, set_name)))
+            g = flatten([[*ty.c_tdecl(), *ty.decl] for ty in specialized_types])
+            self.g_specialized[set_name] = [
+                "// Auto-generated file",
+                "",
+                "#pragma once",
+                "",
+                "#include <jam_types/common-types-%s.hpp>" % set_name,
+                "#include <jam_types/%s-types.hpp>" % name,
+                "",
+                "namespace %s::%s {" % (ns, name),
+                "",
+                *indent(usings),
+                "",
+                *indent(g),
+                "",
+                "}",
+            ]
+
     def write(self, name: str):
         prefix = os.path.join(OUTPUT_DIR, name)
         write(prefix + "-types.hpp", self.g_types)
         write(prefix + "-diff.hpp", self.g_diff)
+        for set_name, content in self.g_specialized.items():
+            write(prefix + "-types-%s.hpp" % set_name, content)
+
+
+def c_snake(name: str):
+    return re.sub(r"(?<!^)(?=[A-Z])", "_", name).lower()
+
+
+class GenCodecBench:
+    """
+    Round-trip benchmark of every composite type of schema.
+    Common types use samples from codec test vectors, module types use
+    members of test cases of enabled modules.
+    """
+
+    def __init__(self, cpp_namespace: str, path: str, modules: list[str]):
+        common: dict = asn1tools.parse_files([asn_file("%s/jam-types" % path)])["JamTypes"]["types"]
+        includes = ["#include <jam_types/common-types.hpp>"]
+        calls = []
+        for tname, t in common.items():
+            if t["type"] in ("SEQUENCE", "CHOICE"):
+                calls.append('bench.common<%s>("%s", "%s");' % (tname, tname, c_snake(tname)))
+        for name in modules:
+            module_path, module = MODULES[name]
+            types: dict = asn1tools.parse_files([asn_file(module_path)])[module]["types"]
+            includes += [
+                "#include <jam_types/%s-types.hpp>" % name,
+                "#include <test-vectors/%s/vectors.hpp>" % name,
+            ]
+            benched = set()
+            for member in types["TestCase"]["members"]:
+                if member["type"] in benched:
+                    continue
+                benched.add(member["type"])
+                calls += [
+                    "bench.member<%s::Vectors, %s::TestCase>(" % (name, name),
+                    '    "%s::%s",' % (name, member["type"]),
+                    "    [](const %s::TestCase &c) -> const auto & { return c.%s; });"
+                    % (name, c_dash(member["name"])),
+                ]
+        self.g_bench = [
+            "// Auto-generated file",
+            "",
+            *includes,
+            "#include <test-vectors/codec-bench.hpp>",
+            "",
+            "int main(int argc, char **argv) {",
+            "  using namespace %s;" % cpp_namespace,
+            "  CodecBench bench{argc, argv};",
+            *indent(calls),
+            "}",
+        ]
+
+    def write(self):
+        write(os.path.join(OUTPUT_DIR, "codec-types.bench.cpp"), self.g_bench)
 
 
 def constants():
@@ -513,53 +763,39 @@ def types():
     g.write()
 
 
-def history():
-    g = GenSpecialTypes(
-        "jam::test_vectors",
-        "history",
-        "history/history",
-        "HistoryModule",
-    )
-    g.write("history")
-
-
-def safrole():
-    g = GenSpecialTypes(
-        "jam::test_vectors",
-        "safrole",
-        "safrole/safrole",
-        "SafroleModule",
-    )
-    g.write("safrole")
+# State transition modules: asn file and ASN.1 module name
+MODULES = {
+    "history": ("history/history", "HistoryModule"),
+    "safrole": ("safrole/safrole", "SafroleModule"),
+    "disputes": ("disputes/disputes", "DisputesModule"),
+    "authorizations": ("authorizations/authorizations", "AuthorizationsModule"),
+}
 
 
-def disputes():
+def special_types(name: str):
+    path, module = MODULES[name]
     g = GenSpecialTypes(
         "jam::test_vectors",
-        "disputes",
-        "disputes/disputes",
-        "DisputesModule",
+        name,
+        path,
+        module,
     )
-    g.write("disputes")
+    g.write(name)
 
 
-def authorizations():
-    g = GenSpecialTypes(
+def codec_bench(modules: list[str]):
+    g = GenCodecBench(
         "jam::test_vectors",
-        "authorizations",
-        "authorizations/authorizations",
-        "AuthorizationsModule",
+        "jam-types-asn",
+        modules,
     )
-    g.write("authorizations")
+    g.write()
 
 
 generators = {
     "constants": constants,
     "types": types,
-    "history": history,
-    "safrole": safrole,
-    "disputes": disputes,
-    "authorizations": authorizations,
+    **{name: (lambda name=name: special_types(name)) for name in MODULES},
 }
 
 if __name__ == "__main__":
@@ -574,6 +810,11 @@ if __name__ == "__main__":
     if not os.path.exists(OUTPUT_DIR):
         os.makedirs(OUTPUT_DIR)
 
+    # Benchmark takes names of enabled modules instead of other targets
+    if sys.argv[2] == "codec_bench":
+        codec_bench(sys.argv[3:])
+        sys.exit(0)
+
     for name in sys.argv[2:]:
         if name not in generators:
             print(f"Generator '{name}' does not exist")
@@ -5,8 +5,10 @@
 
 #pragma once
 
+#include <chrono>
 #include <filesystem>
 #include <string>
+#include <unordered_map>
 
 #include <boost/asio/ip/tcp.hpp>
 #include <utils/ctor_limiters.hpp>
@@ -19,6 +21,20 @@ namespace jam::app {
     struct DatabaseConfig {
       std::filesystem::path directory = "db";
       size_t cache_size = 1 << 30;  // 1GiB
+      /// Shares of `cache_size` reserved for spaces, by name of space;
+      /// other spaces share the rest
+      std::unordered_map<std::string, double> column_cache_size{};
+      /// Time to live of values of spaces in seconds, by name of space
+      std::unordered_map<std::string, int32_t> column_ttl{};
+      /// Spaces accessed through write-back cache, with its size in bytes,
+      /// by name of space
+      std::unordered_map<std::string, size_t> cached_columns{};
+      /// Length of key prefix of spaces, indexed by prefix bloom filters for
+      /// prefix cursors, by name of space
+      std::unordered_map<std::string, size_t> column_prefix_length{};
+      /// Period of sync of write-ahead log; if zero, it is synced only by
+      /// commits requesting it (e.g. of finalized blocks)
+      std::chrono::milliseconds wal_sync_interval{0};
     };
 
     struct MetricsConfig {
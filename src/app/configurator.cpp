@@ -389,6 +389,114 @@ namespace jam::app {
               file_has_error_ = true;
             }
           }
+          auto column_cache_size = section["column_cache_size"];
+          if (column_cache_size.IsDefined()) {
+            if (column_cache_size.IsMap()) {
+              double total = 0;
+              for (const auto &item : column_cache_size) {
+                auto name = item.first.as<std::string>();
+                double share = 0;
+                if (item.second.IsScalar()
+                    and YAML::convert<double>::decode(item.second, share)
+                    and share >= 0 and share <= 1) {
+                  config_->database_.column_cache_size[name] = share;
+                  total += share;
+                } else {
+                  file_errors_ << "E: Value 'database.column_cache_size."
+                               << name << "' must be number from 0 to 1\n";
+                  file_has_error_ = true;
+                }
+              }
+              if (total > 1) {
+                file_errors_ << "E: Sum of 'database.column_cache_size' values "
+                                "must not be greater than 1\n";
+                file_has_error_ = true;
+              }
+            } else {
+              file_errors_
+                  << "E: Value 'database.column_cache_size' must be map\n";
+              file_has_error_ = true;
+            }
+          }
+          auto column_ttl = section["column_ttl"];
+          if (column_ttl.IsDefined()) {
+            if (column_ttl.IsMap()) {
+              for (const auto &item : column_ttl) {
+                auto name = item.first.as<std::string>();
+                int32_t ttl = 0;
+                if (item.second.IsScalar()
+                    and YAML::convert<int32_t>::decode(item.second, ttl)
+                    and ttl >= 0) {
+                  config_->database_.column_ttl[name] = ttl;
+                } else {
+                  file_errors_ << "E: Value 'database.column_ttl." << name
+                               << "' must be non-negative number of seconds\n";
+                  file_has_error_ = true;
+                }
+              }
+            } else {
+              file_errors_ << "E: Value 'database.column_ttl' must be map\n";
+              file_has_error_ = true;
+            }
+          }
+          auto cached_columns = section["cached_columns"];
+          if (cached_columns.IsDefined()) {
+            if (cached_columns.IsMap()) {
+              for (const auto &item : cached_columns) {
+                auto name = item.first.as<std::string>();
+                auto size =
+                    item.second.IsScalar()
+                        ? util::parseByteQuantity(item.second.as<std::string>())
+                        : std::nullopt;
+                if (size.has_value()) {
+                  config_->database_.cached_columns[name] = size.value();
+                } else {
+                  file_errors_ << "E: Bad 'database.cached_columns." << name
+                               << "' value; Expected: 4096, 512Mb, 1G, etc.\n";
+                  file_has_error_ = true;
+                }
+              }
+            } else {
+              file_errors_
+                  << "E: Value 'database.cached_columns' must be map\n";
+              file_has_error_ = true;
+            }
+          }
+          auto column_prefix_length = section["column_prefix_length"];
+          if (column_prefix_length.IsDefined()) {
+            if (column_prefix_length.IsMap()) {
+              for (const auto &item : column_prefix_length) {
+                auto name = item.first.as<std::string>();
+                size_t length = 0;
+                if (item.second.IsScalar()
+                    and YAML::convert<size_t>::decode(item.second, length)
+                    and length > 0) {
+                  config_->database_.column_prefix_length[name] = length;
+                } else {
+                  file_errors_ << "E: Value 'database.column_prefix_length."
+                               << name << "' must be positive number\n";
+                  file_has_error_ = true;
+                }
+              }
+            } else {
+              file_errors_
+                  << "E: Value 'database.column_prefix_length' must be map\n";
+              file_has_error_ = true;
+            }
+          }
+          auto wal_sync_interval = section["wal_sync_interval"];
+          if (wal_sync_interval.IsDefined()) {
+            uint32_t value = 0;
+            if (wal_sync_interval.IsScalar()
+                and YAML::convert<uint32_t>::decode(wal_sync_interval, value)) {
+              config_->database_.wal_sync_interval =
+                  std::chrono::milliseconds{value};
+            } else {
+              file_errors_ << "E: Value 'database.wal_sync_interval' must be "
+                              "number of milliseconds\n";
+              file_has_error_ = true;
+            }
+          }
         } else {
           file_errors_ << "E: Section 'database' defined, but is not map\n";
           file_has_error_ = true;
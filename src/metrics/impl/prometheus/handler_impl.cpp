@@ -46,6 +46,8 @@ namespace jam::metrics {
                                            std::shared_ptr<Session> session) {
     std::vector<MetricFamily> metrics;
 
+    PrometheusRegistry::runCollectors();
+
     {
       std::lock_guard<std::mutex> lock{collectables_mutex_};
       metrics = CollectMetrics(collectables_);
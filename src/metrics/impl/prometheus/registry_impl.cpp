@@ -7,7 +7,9 @@
 #include "metrics/impl/prometheus/registry_impl.hpp"
 
 #include "metrics/handler.hpp"
+#include "metrics/metrics.hpp"
 #include "metrics/registry.hpp"
+#include "utils/retain_if.hpp"
 
 namespace jam::metrics {
 
@@ -19,6 +21,26 @@ namespace jam::metrics {
     handler.registerCollectable(*this);
   }
 
+  void PrometheusRegistry::registerCollector(
+      std::weak_ptr<Collector> collector) {
+    auto &collectors = PrometheusRegistry::collectors();
+    std::lock_guard lock{collectors.mutex};
+    collectors.list.emplace_back(std::move(collector));
+  }
+
+  void PrometheusRegistry::runCollectors() {
+    auto &collectors = PrometheusRegistry::collectors();
+    std::lock_guard lock{collectors.mutex};
+    retain_if(collectors.list, [](const std::weak_ptr<Collector> &weak) {
+      auto collector = weak.lock();
+      if (not collector) {
+        return false;
+      }
+      collector->collect();
+      return true;
+    });
+  }
+
   void PrometheusRegistry::registerCounterFamily(
       const std::string &name,
       const std::string &help,
@@ -9,6 +9,7 @@
 #include <forward_list>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <tuple>
 #include <type_traits>
 
@@ -107,16 +108,34 @@ namespace jam::metrics {
           typename MetricInfo<T>::dtype(var));
     }
 
+    struct Collectors {
+      std::mutex mutex;
+      std::vector<std::weak_ptr<Collector>> list;
+    };
+
+    // shared by all registries, like prometheus registry
+    static Collectors &collectors() {
+      static Collectors collectors;
+      return collectors;
+    }
+
+   public:
+    // prometheus registry shared by all registries, gathered by handler
     static std::shared_ptr<prometheus::Registry> registry() {
       static auto registry = std::make_shared<prometheus::Registry>();
       return registry;
     }
 
-   public:
+    // ask alive collectors to update their metrics, called by handler before
+    // gathering metrics
+    static void runCollectors();
+
     // Handler has access to internal prometheus registry and gathers metrics,
     // prepares them for sending by http
     void setHandler(Handler &handler) override;
 
+    void registerCollector(std::weak_ptr<Collector> collector) override;
+
     void registerCounterFamily(
         const std::string &name,
         const std::string &help,
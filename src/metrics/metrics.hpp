@@ -34,6 +34,21 @@ namespace jam::metrics {
     virtual void inc(double val) = 0;
   };
 
+  /**
+   * @brief source of metrics updated on demand, e.g. read from statistics of
+   * other library
+   * @see Registry::registerCollector
+   */
+  class Collector {
+   public:
+    virtual ~Collector() = default;
+
+    /**
+     * @brief update metrics, called before each collection
+     */
+    virtual void collect() = 0;
+  };
+
   /**
    * @brief A gauge metric to represent a value that can arbitrarily go up and
    * down.
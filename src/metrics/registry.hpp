@@ -8,11 +8,13 @@
 
 #include <chrono>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace jam::metrics {
 
+  class Collector;
   class Counter;
   class Gauge;
   class Handler;
@@ -34,6 +36,13 @@ namespace jam::metrics {
     virtual ~Registry() = default;
     virtual void setHandler(Handler &handler) = 0;
 
+    /**
+     * @brief register source of metrics which are expensive to keep up to
+     * date, it is asked to update them before each collection
+     * @param collector is called while it is alive
+     */
+    virtual void registerCollector(std::weak_ptr<Collector> collector) = 0;
+
     virtual void registerCounterFamily(
         const std::string &name,
         const std::string &help = "",
@@ -6,29 +6,289 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <span>
+#include <system_error>
+#include <vector>
+
+#include <qtils/outcome.hpp>
 #include <scale/scale.hpp>
 
 namespace jam {
   using scale::decode;
   using scale::encode;
 
+  /**
+   * Encoder backend, which only counts encoded bytes.
+   */
+  class CountingEncoder final : public scale::Encoder {
+   public:
+    template <typename... Configs>
+    explicit CountingEncoder(const Configs &...configs) : Encoder(configs...) {}
+
+    void put(uint8_t) override {
+      ++size_;
+    }
+
+    void write(std::span<const uint8_t> bytes) override {
+      size_ += bytes.size();
+    }
+
+    [[nodiscard]] size_t size() const override {
+      return size_;
+    }
+
+   private:
+    size_t size_ = 0;
+  };
+
+  /**
+   * Encoder backend, which writes into caller-provided buffer.
+   * Throws `std::errc::no_buffer_space` if buffer is too small.
+   */
+  class SpanEncoder final : public scale::Encoder {
+   public:
+    template <typename... Configs>
+    explicit SpanEncoder(std::span<uint8_t> out, const Configs &...configs)
+        : Encoder(configs...), out_{out} {}
+
+    void put(uint8_t byte) override {
+      reserve(1);
+      out_[size_++] = byte;
+    }
+
+    void write(std::span<const uint8_t> bytes) override {
+      reserve(bytes.size());
+      std::ranges::copy(bytes, out_.begin() + size_);
+      size_ += bytes.size();
+    }
+
+    [[nodiscard]] size_t size() const override {
+      return size_;
+    }
+
+   private:
+    void reserve(size_t n) const {
+      if (out_.size() - size_ < n) {
+        throw std::system_error{
+            std::make_error_code(std::errc::no_buffer_space)};
+      }
+    }
+
+    std::span<uint8_t> out_;
+    size_t size_ = 0;
+  };
+
+  /// Size of encoding of value
+  template <typename T, typename... Configs>
+  [[nodiscard]] outcome::result<size_t> encoded_size(
+      const T &value, const Configs &...configs) {
+    CountingEncoder encoder(configs...);
+    try {
+      encode(value, encoder);
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+    return encoder.size();
+  }
+
+  /// Encode value into caller-provided buffer, returns number of written bytes
+  template <typename T, typename... Configs>
+  [[nodiscard]] outcome::result<size_t> encode_into(
+      std::span<uint8_t> out, const T &value, const Configs &...configs) {
+    SpanEncoder encoder(out, configs...);
+    try {
+      encode(value, encoder);
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+    return encoder.size();
+  }
+
+  /**
+   * Append encoding of value to `out`.
+   * Size is counted first, so `out` grows at most once and by exact size.
+   */
+  template <typename T, typename... Configs>
+  [[nodiscard]] outcome::result<void> encode_append(
+      std::vector<uint8_t> &out, const T &value, const Configs &...configs) {
+    OUTCOME_TRY(size, encoded_size(value, configs...));
+    const auto offset = out.size();
+    out.resize(offset + size);
+    auto written =
+        encode_into(std::span{out}.subspan(offset), value, configs...);
+    if (not written) {
+      out.resize(offset);
+      return written.error();
+    }
+    return outcome::success();
+  }
+
   template <typename T, typename... Configs>
   [[nodiscard]] outcome::result<std::vector<uint8_t>> encode_with_config(
-      T &&value, Configs &&...configs) {
+      const T &value, const Configs &...configs) {
     std::vector<uint8_t> out;
-    scale::backend::ToBytes encoder(out, std::forward<Configs>(configs)...);
+    OUTCOME_TRY(encode_append(out, value, configs...));
+    return std::move(out);
+  }
+
+  /**
+   * Encoder backend, which streams encoded bytes into hasher (e.g.
+   * `crypto::Blake` or `crypto::Keccak`) instead of collecting them.
+   * Small writes are gathered in inline buffer; `flush` must be called before
+   * taking hash.
+   */
+  template <typename Hasher>
+  class HashingEncoder final : public scale::Encoder {
+   public:
+    template <typename... Configs>
+    explicit HashingEncoder(Hasher &hasher, const Configs &...configs)
+        : Encoder(configs...), hasher_{hasher} {}
+
+    void put(uint8_t byte) override {
+      if (used_ == buffer_.size()) {
+        flush();
+      }
+      buffer_[used_++] = byte;
+      ++size_;
+    }
+
+    void write(std::span<const uint8_t> bytes) override {
+      if (used_ + bytes.size() > buffer_.size()) {
+        flush();
+      }
+      if (bytes.size() >= buffer_.size()) {
+        hasher_.update(bytes);
+      } else {
+        std::ranges::copy(bytes, buffer_.begin() + used_);
+        used_ += bytes.size();
+      }
+      size_ += bytes.size();
+    }
+
+    [[nodiscard]] size_t size() const override {
+      return size_;
+    }
+
+    /// Pass buffered bytes to hasher
+    void flush() {
+      if (used_ != 0) {
+        hasher_.update(std::span{buffer_.data(), used_});
+        used_ = 0;
+      }
+    }
+
+   private:
+    Hasher &hasher_;
+    std::array<uint8_t, 128> buffer_;
+    size_t used_ = 0;
+    size_t size_ = 0;
+  };
+
+  /**
+   * Hash encoding of value, without materializing it.
+   * Same as `Hasher::hash(encode_with_config(value, configs...).value())`.
+   */
+  template <typename Hasher, typename T, typename... Configs>
+  [[nodiscard]] outcome::result<decltype(std::declval<Hasher &>().hash())>
+  hash_encoded(const T &value, const Configs &...configs) {
+    Hasher hasher;
+    HashingEncoder encoder(hasher, configs...);
     try {
-      encode(std::forward<T>(value), encoder);
+      encode(value, encoder);
     } catch (std::system_error &e) {
       return outcome::failure(e.code());
     }
-    return std::move(out);
+    encoder.flush();
+    return hasher.hash();
+  }
+
+  /**
+   * Decode into existing `value`, e.g. allocated on heap when it is too
+   * large for stack.
+   */
+  template <typename T, typename... Configs>
+  [[nodiscard]] outcome::result<void> decode_into(T &value,
+                                                  const auto &bytes,
+                                                  Configs &&...configs) {
+    scale::backend::FromBytes decoder(bytes, std::forward<Configs>(configs)...);
+    try {
+      decode(value, decoder);
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+    return outcome::success();
   }
 
   template <typename T, typename... Configs>
   [[nodiscard]] outcome::result<T> decode_with_config(
       const auto &bytes, Configs &&...configs) {
-    scale::backend::FromBytes decoder(bytes, std::forward<Configs>(configs)...);
+    T value;
+    OUTCOME_TRY(decode_into(value, bytes, std::forward<Configs>(configs)...));
+    return std::move(value);
+  }
+
+  /**
+   * Decoder backend over bytes kept by caller, which also allows to borrow
+   * decoded bytes instead of copying them (see `borrow`).
+   */
+  class BorrowingDecoder final : public scale::Decoder {
+   public:
+    template <typename... Configs>
+    explicit BorrowingDecoder(std::span<const uint8_t> in,
+                              const Configs &...configs)
+        : Decoder(configs...), in_{in} {}
+
+    [[nodiscard]] bool has(size_t amount) const override {
+      return in_.size() - offset_ >= amount;
+    }
+
+    uint8_t take() override {
+      require(1);
+      return in_[offset_++];
+    }
+
+    void read(std::span<uint8_t> out) override {
+      require(out.size());
+      std::ranges::copy(in_.subspan(offset_, out.size()), out.begin());
+      offset_ += out.size();
+    }
+
+    /// Take next `n` bytes as view into input
+    std::span<const uint8_t> borrow(size_t n) {
+      require(n);
+      auto bytes = in_.subspan(offset_, n);
+      offset_ += n;
+      return bytes;
+    }
+
+    /// Number of bytes decoded so far
+    size_t consumed() const {
+      return offset_;
+    }
+
+   private:
+    void require(size_t n) const {
+      if (not has(n)) {
+        throw std::system_error{
+            std::make_error_code(std::errc::result_out_of_range)};
+      }
+    }
+
+    std::span<const uint8_t> in_;
+    size_t offset_ = 0;
+  };
+
+  /**
+   * Decode value, which may borrow bytes from `bytes` (e.g. view types), so
+   * `bytes` must outlive it.
+   */
+  template <typename T, typename... Configs>
+  [[nodiscard]] outcome::result<T> decode_borrowed(
+      std::span<const uint8_t> bytes, const Configs &...configs) {
+    BorrowingDecoder decoder(bytes, configs...);
     T value;
     try {
       decode(value, decoder);
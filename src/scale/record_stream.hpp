@@ -0,0 +1,75 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <tuple>
+
+#include "scale/jam_scale.hpp"
+#include "utils/mapped_file.hpp"
+
+namespace jam {
+
+  /**
+   * Decodes concatenated SCALE records (e.g. blocks of chain export) from
+   * memory mapped file one at a time.
+   * Pages of already decoded records are released, so memory usage stays
+   * bounded regardless of file size.
+   * Records are decoded by `BorrowingDecoder`, so view types may be used;
+   * their bytes stay valid while stream exists.
+   */
+  template <typename T, typename... Configs>
+  class RecordStream {
+   public:
+    /// Decoded bytes are released in steps of this size
+    static constexpr size_t kReleaseStep = size_t{16} << 20;
+
+    explicit RecordStream(MappedFile file, Configs... configs)
+        : file_{std::move(file)}, configs_{std::move(configs)...} {}
+
+    /// All records are decoded
+    bool done() const {
+      return offset_ == file_.bytes().size();
+    }
+
+    /// Offset of next record in file
+    size_t offset() const {
+      return offset_;
+    }
+
+    /// Decode next record
+    outcome::result<T> next() {
+      auto bytes = file_.bytes().subspan(offset_);
+      if (bytes.empty()) {
+        return std::make_error_code(std::errc::result_out_of_range);
+      }
+      // Decoder refers to stored configs
+      auto decoder = std::make_from_tuple<BorrowingDecoder>(std::tuple_cat(
+          std::tuple{bytes},
+          std::apply([](const auto &...c) { return std::tie(c...); },
+                     configs_)));
+      T value;
+      try {
+        decode(value, decoder);
+      } catch (std::system_error &e) {
+        return outcome::failure(e.code());
+      }
+      offset_ += decoder.consumed();
+      if (offset_ - released_ >= kReleaseStep) {
+        file_.release(offset_);
+        released_ = offset_;
+      }
+      return std::move(value);
+    }
+
+   private:
+    MappedFile file_;
+    std::tuple<Configs...> configs_;
+    size_t offset_ = 0;
+    size_t released_ = 0;
+  };
+
+}  // namespace jam
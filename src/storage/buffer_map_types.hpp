@@ -56,6 +56,11 @@ namespace jam::storage {
    */
   using BufferBatch = face::WriteBatch<ByteVec, ByteVec>;
 
+  /**
+   * @brief Alias for a byte-vector write batch readable before commit.
+   */
+  using BufferIndexedBatch = face::IndexedBatch<ByteVec, ByteVec>;
+
   /**
    * @brief Alias for generic byte-vector storage.
    *
@@ -63,6 +68,13 @@ namespace jam::storage {
    */
   using BufferStorage = face::GenericStorage<ByteVec, ByteVec>;
 
+  /**
+   * @brief Alias for read-only byte-vector storage.
+   *
+   * Combines read and iteration support for ByteVec, e.g. for snapshots.
+   */
+  using BufferReadableStorage = face::ReadableStorage<ByteVec, ByteVec>;
+
   /**
    * @brief Cursor type for iterating over byte-vector storage.
    */
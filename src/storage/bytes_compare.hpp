@@ -0,0 +1,47 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Comparison and hashing of byte strings for containers keyed by
+ * bytes.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <string_view>
+
+#include <qtils/bytes.hpp>
+
+namespace jam::storage {
+
+  /**
+   * Lexicographic order of byte strings, same as order of RocksDB default
+   * comparator. Transparent, so lookups by view do not allocate.
+   */
+  struct BytesLess {
+    using is_transparent = void;
+
+    bool operator()(qtils::BytesIn lhs, qtils::BytesIn rhs) const {
+      return std::ranges::lexicographical_compare(lhs, rhs);
+    }
+  };
+
+  struct BytesHash {
+    size_t operator()(qtils::BytesIn bytes) const {
+      return std::hash<std::string_view>{}(
+          {reinterpret_cast<const char *>(bytes.data()), bytes.size()});
+    }
+  };
+
+  struct BytesEqual {
+    bool operator()(qtils::BytesIn lhs, qtils::BytesIn rhs) const {
+      return std::ranges::equal(lhs, rhs);
+    }
+  };
+
+}  // namespace jam::storage
@@ -0,0 +1,182 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <qtils/byte_vec.hpp>
+
+#include "storage/cached/cached_storage.hpp"
+
+namespace jam::storage {
+  /**
+   * Cursor over backend entries merged with buffered changes of
+   * `CachedStorage`: overlay values replace backend ones, removed keys are
+   * skipped.
+   * Backend cursor is kept at current key, or next to it in direction of
+   * movement when current key is only in overlay.
+   * Storage is locked on each step; view of buffered value is valid until
+   * the key is changed again.
+   */
+  class CachedCursor : public BufferStorageCursor {
+   public:
+    CachedCursor(CachedStorage &db,
+                 std::unique_ptr<BufferStorageCursor> backend)
+        : db{db}, backend_{std::move(backend)} {}
+
+    outcome::result<bool> seekFirst() override {
+      std::lock_guard lock{db.mutex_};
+      OUTCOME_TRY(backend_->seekFirst());
+      return forward(db.overlay_.begin());
+    }
+
+    outcome::result<bool> seek(const ByteView &key) override {
+      std::lock_guard lock{db.mutex_};
+      OUTCOME_TRY(backend_->seek(key));
+      return forward(db.overlay_.lower_bound(key));
+    }
+
+    outcome::result<bool> seekLast() override {
+      std::lock_guard lock{db.mutex_};
+      OUTCOME_TRY(backend_->seekLast());
+      return backward(db.overlay_.end());
+    }
+
+    bool isValid() const override {
+      return key_.has_value();
+    }
+
+    outcome::result<void> next() override {
+      std::lock_guard lock{db.mutex_};
+      auto key = std::move(*key_);
+      if (not forward_) {
+        OUTCOME_TRY(backend_->seek(key));
+      }
+      if (backend_->isValid() and *backend_->keyView() == ByteView{key}) {
+        OUTCOME_TRY(backend_->next());
+      }
+      OUTCOME_TRY(forward(db.overlay_.upper_bound(key)));
+      return outcome::success();
+    }
+
+    outcome::result<void> prev() override {
+      std::lock_guard lock{db.mutex_};
+      auto key = std::move(*key_);
+      if (forward_) {
+        OUTCOME_TRY(backend_->seekReverse(key));
+      }
+      if (backend_->isValid() and *backend_->keyView() == ByteView{key}) {
+        OUTCOME_TRY(backend_->prev());
+      }
+      OUTCOME_TRY(backward(db.overlay_.lower_bound(key)));
+      return outcome::success();
+    }
+
+    std::optional<ByteVec> key() const override {
+      return key_;
+    }
+
+    std::optional<ByteVecOrView> value() const override {
+      if (not key_) {
+        return std::nullopt;
+      }
+      std::lock_guard lock{db.mutex_};
+      if (auto it = db.overlay_.find(*key_); it != db.overlay_.end()) {
+        if (it->second) {
+          return ByteView{*it->second};
+        }
+        return std::nullopt;
+      }
+      return backend_->value();
+    }
+
+    std::optional<ByteView> keyView() const override {
+      if (key_) {
+        return ByteView{*key_};
+      }
+      return std::nullopt;
+    }
+
+    std::optional<ByteView> valueView() const override {
+      if (not key_) {
+        return std::nullopt;
+      }
+      std::lock_guard lock{db.mutex_};
+      if (auto it = db.overlay_.find(*key_); it != db.overlay_.end()) {
+        if (it->second) {
+          return ByteView{*it->second};
+        }
+        return std::nullopt;
+      }
+      return backend_->valueView();
+    }
+
+   private:
+    using Overlay = CachedStorage::Overlay;
+
+    /**
+     * Move to smallest of backend key and overlay key at `it`, skipping
+     * removed keys
+     */
+    outcome::result<bool> forward(Overlay::const_iterator it) {
+      forward_ = true;
+      while (true) {
+        auto backend_key = backend_->isValid() ? backend_->key() : std::nullopt;
+        if (it == db.overlay_.end()) {
+          key_ = std::move(backend_key);
+          return isValid();
+        }
+        if (backend_key and BytesLess{}(*backend_key, it->first)) {
+          key_ = std::move(backend_key);
+          return true;
+        }
+        if (it->second) {
+          key_ = it->first;
+          return true;
+        }
+        // Removed in overlay
+        if (backend_key and *backend_key == it->first) {
+          OUTCOME_TRY(backend_->next());
+        }
+        ++it;
+      }
+    }
+
+    /**
+     * Move to greatest of backend key and overlay key before `it`, skipping
+     * removed keys
+     */
+    outcome::result<bool> backward(Overlay::const_iterator it) {
+      forward_ = false;
+      while (true) {
+        auto backend_key = backend_->isValid() ? backend_->key() : std::nullopt;
+        if (it == db.overlay_.begin()) {
+          key_ = std::move(backend_key);
+          return isValid();
+        }
+        auto prev = std::prev(it);
+        if (backend_key and BytesLess{}(prev->first, *backend_key)) {
+          key_ = std::move(backend_key);
+          return true;
+        }
+        if (prev->second) {
+          key_ = prev->first;
+          return true;
+        }
+        // Removed in overlay
+        if (backend_key and *backend_key == prev->first) {
+          OUTCOME_TRY(backend_->prev());
+        }
+        it = prev;
+      }
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    CachedStorage &db;
+    std::unique_ptr<BufferStorageCursor> backend_;
+    std::optional<ByteVec> key_;
+    bool forward_ = true;
+  };
+}  // namespace jam::storage
@@ -0,0 +1,219 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/cached/cached_storage.hpp"
+
+#include "metrics/registry.hpp"
+#include "storage/cached/cached_cursor.hpp"
+#include "storage/in_memory/in_memory_batch.hpp"
+#include "storage/in_memory/in_memory_indexed_batch.hpp"
+#include "storage/storage_error.hpp"
+
+namespace jam::storage {
+  namespace {
+    constexpr auto kHits = "jam_storage_cache_hits_total";
+    constexpr auto kMisses = "jam_storage_cache_misses_total";
+  }  // namespace
+
+  CachedStorage::CachedStorage(std::shared_ptr<BufferStorage> backend,
+                               size_t capacity,
+                               const std::string &name,
+                               log::Logger logger)
+      : backend_{std::move(backend)},
+        capacity_{capacity},
+        logger_{std::move(logger)},
+        metrics_registry_{metrics::createRegistry()} {
+    BOOST_ASSERT(backend_);
+    metrics_registry_->registerCounterFamily(
+        kHits, "Reads of storage answered by cache");
+    metrics_registry_->registerCounterFamily(
+        kMisses, "Reads of storage passed to backend");
+    metric_hits_ =
+        metrics_registry_->registerCounterMetric(kHits, {{"space", name}});
+    metric_misses_ =
+        metrics_registry_->registerCounterMetric(kMisses, {{"space", name}});
+  }
+
+  CachedStorage::~CachedStorage() {
+    if (auto res = commit(); res.has_error()) {
+      SL_ERROR(logger_,
+               "Can't commit {} buffered changes on destruction: {}",
+               overlay_.size(),
+               res.error());
+    }
+  }
+
+  CachedStorage::Commit::Commit(CachedStorage &storage)
+      : storage_{storage}, lock_{storage.mutex_} {}
+
+  void CachedStorage::Commit::done(const Keys &replaced) {
+    ++storage_.generation_;
+    auto &overlay = storage_.overlay_;
+    for (auto &key : replaced) {
+      overlay.erase(key);
+      storage_.forget(key);
+    }
+    // Written values are likely to be read again
+    while (not overlay.empty()) {
+      auto node = overlay.extract(overlay.begin());
+      storage_.remember(node.key(), std::move(node.mapped()));
+    }
+  }
+
+  outcome::result<std::optional<ByteVec>> CachedStorage::lookup(
+      const ByteView &key) const {
+    std::unique_lock lock{mutex_};
+    if (auto value = cached(key)) {
+      metric_hits_->inc();
+      return *value;
+    }
+    metric_misses_->inc();
+    const auto generation = generation_;
+    lock.unlock();
+    OUTCOME_TRY(read, backend_->tryGet(key));
+    std::optional<ByteVec> value;
+    if (read) {
+      value = std::move(*read).intoByteVec();
+    }
+    lock.lock();
+    // Key may be written or read by others while backend was read
+    if (auto newer = cached(key)) {
+      return *newer;
+    }
+    if (generation_ == generation) {
+      remember(key, value);
+    }
+    return value;
+  }
+
+  const std::optional<ByteVec> *CachedStorage::cached(
+      const ByteView &key) const {
+    if (auto it = overlay_.find(key); it != overlay_.end()) {
+      return &it->second;
+    }
+    if (auto it = lru_index_.find(key); it != lru_index_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return &it->second->value;
+    }
+    return nullptr;
+  }
+
+  void CachedStorage::remember(const ByteView &key,
+                               std::optional<ByteVec> value) const {
+    // Key is copied first, it may point to entry being replaced
+    Entry entry{
+        .key = ByteVec(key.begin(), key.end()),
+        .value = std::move(value),
+    };
+    forget(entry.key);
+    lru_size_ += entry.key.size() + (entry.value ? entry.value->size() : 0);
+    lru_.push_front(std::move(entry));
+    lru_index_.emplace(lru_.front().key, lru_.begin());
+    // Most recent entry is kept even if it alone exceeds capacity
+    while (lru_size_ > capacity_ and lru_.size() > 1) {
+      forget(lru_.back().key);
+    }
+  }
+
+  void CachedStorage::forget(const ByteView &key) const {
+    auto it = lru_index_.find(key);
+    if (it == lru_index_.end()) {
+      return;
+    }
+    auto entry = it->second;
+    lru_size_ -= entry->key.size() + (entry->value ? entry->value->size() : 0);
+    lru_index_.erase(it);
+    lru_.erase(entry);
+  }
+
+  outcome::result<ByteVecOrView> CachedStorage::get(
+      const ByteView &key) const {
+    OUTCOME_TRY(value, lookup(key));
+    if (not value) {
+      return StorageError::NOT_FOUND;
+    }
+    return std::move(*value);
+  }
+
+  outcome::result<std::optional<ByteVecOrView>> CachedStorage::tryGet(
+      const ByteView &key) const {
+    OUTCOME_TRY(value, lookup(key));
+    if (not value) {
+      return std::nullopt;
+    }
+    return ByteVecOrView{std::move(*value)};
+  }
+
+  outcome::result<bool> CachedStorage::contains(const ByteView &key) const {
+    OUTCOME_TRY(value, lookup(key));
+    return value.has_value();
+  }
+
+  outcome::result<void> CachedStorage::put(const ByteView &key,
+                                           ByteVecOrView &&value) {
+    // Key and value may point to cached entry, which is forgotten below
+    ByteVec owned_key(key.begin(), key.end());
+    auto owned_value = std::move(value).intoByteVec();
+    std::lock_guard lock{mutex_};
+    ++generation_;
+    forget(owned_key);
+    overlay_.insert_or_assign(std::move(owned_key), std::move(owned_value));
+    return outcome::success();
+  }
+
+  outcome::result<void> CachedStorage::remove(const ByteView &key) {
+    ByteVec owned_key(key.begin(), key.end());
+    std::lock_guard lock{mutex_};
+    ++generation_;
+    forget(owned_key);
+    overlay_.insert_or_assign(std::move(owned_key), std::nullopt);
+    return outcome::success();
+  }
+
+  outcome::result<void> CachedStorage::commit() {
+    Commit commit{*this};
+    if (commit.changes().empty()) {
+      return outcome::success();
+    }
+    auto batch = backend_->batch();
+    for (auto &[key, value] : commit.changes()) {
+      if (value) {
+        OUTCOME_TRY(batch->put(key, ByteView{*value}));
+      } else {
+        OUTCOME_TRY(batch->remove(key));
+      }
+    }
+    OUTCOME_TRY(batch->commit());
+    commit.done();
+    return outcome::success();
+  }
+
+  std::unique_ptr<BufferBatch> CachedStorage::batch() {
+    return std::make_unique<InMemoryBatch>(*this);
+  }
+
+  std::unique_ptr<BufferIndexedBatch> CachedStorage::indexedBatch() {
+    return std::make_unique<InMemoryIndexedBatch>(*this, nullptr);
+  }
+
+  std::unique_ptr<CachedStorage::Cursor> CachedStorage::cursor() {
+    return std::make_unique<CachedCursor>(*this, backend_->cursor());
+  }
+
+  std::unique_ptr<CachedStorage::Cursor> CachedStorage::rangeCursor(
+      const ByteView &lower, const std::optional<ByteView> &upper) {
+    return std::make_unique<face::BoundedCursor<ByteVec, ByteVec>>(
+        std::make_unique<CachedCursor>(*this,
+                                       backend_->rangeCursor(lower, upper)),
+        ByteVec{lower.begin(), lower.end()},
+        upper ? std::make_optional(ByteVec{upper->begin(), upper->end()})
+              : std::nullopt);
+  }
+
+  std::optional<size_t> CachedStorage::byteSizeHint() const {
+    return backend_->byteSizeHint();
+  }
+}  // namespace jam::storage
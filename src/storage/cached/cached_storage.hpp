@@ -0,0 +1,169 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#include <qtils/byte_vec.hpp>
+#include <qtils/outcome.hpp>
+
+#include "log/logger.hpp"
+#include "metrics/metrics.hpp"
+#include "storage/buffer_map_types.hpp"
+#include "storage/bytes_compare.hpp"
+
+namespace jam::storage {
+
+  /**
+   * @brief Write-back caching decorator over any storage.
+   *
+   * Recently read values, and absence of values, are kept in LRU bounded by
+   * total size of keys and values. Writes are kept in overlay until `commit`,
+   * which writes them to backend in one batch; they are visible to reads and
+   * cursors of this storage before that. Writes left on destruction are
+   * committed, failure to do so is logged.
+   * Hits and misses of LRU and overlay are exposed as metrics labeled by name.
+   *
+   * Overlay and LRU are guarded by one mutex, which is released while backend
+   * is read on miss. Writes and commits advance generation, and value read
+   * from backend is cached only if generation is unchanged, so it can not
+   * replace newer one. Cursors lock mutex on each step.
+   */
+  class CachedStorage : public BufferStorage {
+   public:
+    /**
+     * @param backend - storage to cache
+     * @param capacity - limit of total size of cached keys and values in
+     * bytes
+     * @param name - name for metrics, e.g. name of space
+     * @param logger - logger of failed commit on destruction
+     */
+    CachedStorage(std::shared_ptr<BufferStorage> backend,
+                  size_t capacity,
+                  const std::string &name,
+                  log::Logger logger);
+
+    ~CachedStorage() override;
+
+    [[nodiscard]] outcome::result<ByteVecOrView> get(
+        const ByteView &key) const override;
+
+    [[nodiscard]] outcome::result<std::optional<ByteVecOrView>> tryGet(
+        const ByteView &key) const override;
+
+    [[nodiscard]] outcome::result<bool> contains(
+        const ByteView &key) const override;
+
+    outcome::result<void> put(const ByteView &key,
+                              ByteVecOrView &&value) override;
+
+    outcome::result<void> remove(const ByteView &key) override;
+
+    std::unique_ptr<BufferBatch> batch() override;
+
+    std::unique_ptr<BufferIndexedBatch> indexedBatch() override;
+
+    std::unique_ptr<Cursor> cursor() override;
+
+    /// Backend cursor is bounded by backend, buffered changes by filtering
+    std::unique_ptr<Cursor> rangeCursor(
+        const ByteView &lower, const std::optional<ByteView> &upper) override;
+
+    [[nodiscard]] std::optional<size_t> byteSizeHint() const override;
+
+    /**
+     * @brief Write buffered changes to backend in one batch.
+     * On failure changes stay buffered.
+     */
+    outcome::result<void> commit();
+
+    /// Number of buffered changes
+    size_t pending() const {
+      std::lock_guard lock{mutex_};
+      return overlay_.size();
+    }
+
+    /// Removed keys are mapped to `std::nullopt`
+    using Overlay = std::map<ByteVec, std::optional<ByteVec>, BytesLess>;
+    using Keys = std::set<ByteVec, BytesLess>;
+
+    /**
+     * @brief Commit of buffered changes written to backend by its owner,
+     * e.g. along with changes of other spaces in one write.
+     *
+     * Storage is locked while instance is alive, so neither reads nor writes
+     * interleave with write of changes.
+     */
+    class Commit {
+     public:
+      explicit Commit(CachedStorage &storage);
+
+      /// Buffered changes to write to backend
+      const Overlay &changes() const {
+        return storage_.overlay_;
+      }
+
+      /**
+       * Changes are written to backend, move them to LRU
+       * @param replaced - keys written to backend along with changes instead
+       * of their buffered changes, which are dropped; their cached values are
+       * evicted
+       */
+      void done(const Keys &replaced = {});
+
+     private:
+      // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+      CachedStorage &storage_;
+      std::unique_lock<std::mutex> lock_;
+    };
+
+   private:
+
+    struct Entry {
+      ByteVec key;
+      std::optional<ByteVec> value;
+    };
+    using Lru = std::list<Entry>;
+
+    /// Copy of value of key (or its absence) from overlay, LRU or backend
+    outcome::result<std::optional<ByteVec>> lookup(const ByteView &key) const;
+
+    /// Value of key (or its absence) in overlay or LRU, nullptr if unknown
+    const std::optional<ByteVec> *cached(const ByteView &key) const;
+
+    /// Put value (or its absence) to LRU as most recently used
+    void remember(const ByteView &key, std::optional<ByteVec> value) const;
+
+    void forget(const ByteView &key) const;
+
+    std::shared_ptr<BufferStorage> backend_;
+    size_t capacity_;
+    log::Logger logger_;
+    mutable std::mutex mutex_;
+    Overlay overlay_;
+    mutable Lru lru_;
+    mutable std::
+        unordered_map<qtils::BytesIn, Lru::iterator, BytesHash, BytesEqual>
+            lru_index_;
+    mutable size_t lru_size_ = 0;
+    /// Number of writes and commits, to detect them during read of backend
+    uint64_t generation_ = 0;
+
+    std::unique_ptr<metrics::Registry> metrics_registry_;
+    metrics::Counter *metric_hits_;
+    metrics::Counter *metric_misses_;
+
+    friend class CachedCursor;
+  };
+
+}  // namespace jam::storage
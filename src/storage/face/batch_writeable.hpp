@@ -15,6 +15,7 @@
 
 #include <memory>
 
+#include "storage/face/indexed_batch.hpp"
 #include "storage/face/write_batch.hpp"
 
 namespace jam::storage::face {
@@ -42,6 +43,18 @@ namespace jam::storage::face {
     virtual std::unique_ptr<WriteBatch<K, V>> batch() {
       throw std::logic_error{"BatchWriteable::batch not implemented"};
     }
+
+    /**
+     * @brief Create a new write batch, readable before commit.
+     *
+     * @return std::unique_ptr<IndexedBatch<K, V>> A batch object which
+     * reads its own writes. The default implementation throws logic_error
+     * if not overridden.
+     */
+    virtual std::unique_ptr<IndexedBatch<K, V>> indexedBatch() {
+      throw std::logic_error{
+          "BatchWriteable::indexedBatch not implemented"};
+    }
   };
 
 }  // namespace jam::storage::face
@@ -0,0 +1,124 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Cursor restricted to range of keys.
+ *
+ * Generic fallback for storages which can not bound their native iterators,
+ * and for merging cursors whose sources are bounded separately.
+ */
+
+#pragma once
+
+#include <memory>
+#include <optional>
+
+#include "storage/face/map_cursor.hpp"
+
+namespace jam::storage::face {
+
+  /**
+   * @brief Smallest key greater than all keys starting with `prefix`.
+   * @return std::nullopt if there is no such key, i.e. `prefix` is empty or
+   * consists of 0xff bytes only
+   */
+  template <typename K>
+  std::optional<K> prefixEnd(const View<K> &prefix) {
+    K end{prefix.begin(), prefix.end()};
+    while (not end.empty()) {
+      if (++end.back() != 0) {
+        return end;
+      }
+      end.pop_back();
+    }
+    return std::nullopt;
+  }
+
+  /**
+   * @brief Cursor over keys in range [lower, upper) of underlying cursor.
+   * @tparam K key type
+   * @tparam V value type
+   *
+   * Underlying cursor is positioned by seeks and checked against bounds on
+   * each access, so it is invalid as soon as it leaves the range.
+   */
+  template <typename K, typename V>
+  class BoundedCursor : public MapCursor<K, V> {
+   public:
+    /**
+     * @param cursor - underlying cursor
+     * @param lower - smallest key of range
+     * @param upper - key after range, or std::nullopt for unbounded range
+     */
+    BoundedCursor(std::unique_ptr<MapCursor<K, V>> cursor,
+                  K lower,
+                  std::optional<K> upper)
+        : cursor_{std::move(cursor)},
+          lower_{std::move(lower)},
+          upper_{std::move(upper)} {}
+
+    outcome::result<bool> seekFirst() override {
+      OUTCOME_TRY(cursor_->seek(lower_));
+      return isValid();
+    }
+
+    outcome::result<bool> seek(const View<K> &key) override {
+      View<K> lower{lower_};
+      OUTCOME_TRY(cursor_->seek(key < lower ? lower : key));
+      return isValid();
+    }
+
+    outcome::result<bool> seekLast() override {
+      if (not upper_) {
+        OUTCOME_TRY(cursor_->seekLast());
+        return isValid();
+      }
+      OUTCOME_TRY(found, cursor_->seekReverse(*upper_));
+      if (found and *cursor_->keyView() == View<K>{*upper_}) {
+        OUTCOME_TRY(cursor_->prev());
+      }
+      return isValid();
+    }
+
+    bool isValid() const override {
+      if (not cursor_->isValid()) {
+        return false;
+      }
+      auto key = *cursor_->keyView();
+      return key >= View<K>{lower_} and (not upper_ or key < View<K>{*upper_});
+    }
+
+    outcome::result<void> next() override {
+      return cursor_->next();
+    }
+
+    outcome::result<void> prev() override {
+      return cursor_->prev();
+    }
+
+    std::optional<K> key() const override {
+      return isValid() ? cursor_->key() : std::nullopt;
+    }
+
+    std::optional<OwnedOrView<V>> value() const override {
+      return isValid() ? cursor_->value() : std::nullopt;
+    }
+
+    std::optional<View<K>> keyView() const override {
+      return isValid() ? cursor_->keyView() : std::nullopt;
+    }
+
+    std::optional<View<V>> valueView() const override {
+      return isValid() ? cursor_->valueView() : std::nullopt;
+    }
+
+   private:
+    std::unique_ptr<MapCursor<K, V>> cursor_;
+    K lower_;
+    std::optional<K> upper_;
+  };
+
+}  // namespace jam::storage::face
@@ -20,6 +20,15 @@
 
 namespace jam::storage::face {
 
+  /**
+   * @brief Abstraction over a read-only key-value storage supporting
+   * iteration.
+   * @tparam K Key type.
+   * @tparam V Value type.
+   */
+  template <typename K, typename V>
+  struct ReadableStorage : Readable<K, V>, Iterable<K, V> {};
+
   /**
    * @brief Abstraction over a key-value storage supporting read, write,
    * iteration, and batch writes.
@@ -30,8 +39,7 @@ namespace jam::storage::face {
    * API for key-value operations.
    */
   template <typename K, typename V>
-  struct GenericStorage : Readable<K, V>,
-                          Iterable<K, V>,
+  struct GenericStorage : ReadableStorage<K, V>,
                           Writeable<K, V>,
                           BatchWriteable<K, V> {
     /**
@@ -0,0 +1,49 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Interface for write batches readable before commit.
+ *
+ * An IndexedBatch lets later operations read writes of earlier ones before
+ * anything reaches storage, and may be nested to stage changes which can be
+ * discarded separately.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "storage/face/readable.hpp"
+#include "storage/face/write_batch.hpp"
+
+namespace jam::storage::face {
+
+  /**
+   * @brief Write batch with read access to storage as if batch was
+   * committed.
+   *
+   * @tparam K Key type.
+   * @tparam V Value type.
+   *
+   * Reads return values written to batch, or absence of removed ones, and
+   * fall back to underlying storage (or parent batch) otherwise.
+   * Dropping batch without commit discards its changes.
+   */
+  template <typename K, typename V>
+  struct IndexedBatch : public Readable<K, V>, public WriteBatch<K, V> {
+    /**
+     * @brief Create batch on top of this one.
+     *
+     * @details Child reads see changes of both batches; its commit moves
+     * its changes into this batch instead of storage. Child must not
+     * outlive this batch.
+     *
+     * @return std::unique_ptr<IndexedBatch<K, V>> Nested batch.
+     */
+    virtual std::unique_ptr<IndexedBatch<K, V>> child() = 0;
+  };
+
+}  // namespace jam::storage::face
@@ -8,7 +8,7 @@
 
 #include <memory>
 
-#include "storage/face/map_cursor.hpp"
+#include "storage/face/bounded_cursor.hpp"
 
 namespace jam::storage::face {
 
@@ -28,6 +28,34 @@ namespace jam::storage::face {
      * @return kv iterator
      */
     virtual std::unique_ptr<Cursor> cursor() = 0;
+
+    /**
+     * @brief Returns new key-value iterator over keys in range
+     * [lower, upper).
+     * @param upper - key after range, or std::nullopt for range up to end
+     * @return kv iterator, seekFirst() and seekLast() move it to ends of
+     * range. The default implementation filters cursor() by bounds.
+     */
+    virtual std::unique_ptr<Cursor> rangeCursor(
+        const View<K> &lower, const std::optional<View<K>> &upper) {
+      return std::make_unique<BoundedCursor<K, V>>(
+          cursor(),
+          K{lower.begin(), lower.end()},
+          upper ? std::make_optional(K{upper->begin(), upper->end()})
+                : std::nullopt);
+    }
+
+    /**
+     * @brief Returns new key-value iterator over keys starting with
+     * `prefix`.
+     * @return kv iterator
+     */
+    std::unique_ptr<Cursor> prefixCursor(const View<K> &prefix) {
+      auto end = prefixEnd<K>(prefix);
+      return rangeCursor(prefix,
+                         end ? std::make_optional(View<K>{*end})
+                             : std::nullopt);
+    }
   };
 
 }  // namespace jam::storage::face
@@ -50,7 +50,7 @@ namespace jam::storage::face {
       if (not ok) {
         return seekLast();
       }
-      if (View<K>{*key()} > prefix) {
+      if (*keyView() > prefix) {
         OUTCOME_TRY(prev());
         return isValid();
       }
@@ -91,6 +91,22 @@ namespace jam::storage::face {
      * @return value if isValid()
      */
     virtual std::optional<OwnedOrView<V>> value() const = 0;
+
+    /**
+     * @brief Getter for the key of the element currently pointed at, without
+     * copying it.
+     * @return key if isValid(), valid until cursor is moved or map is
+     * modified
+     */
+    virtual std::optional<View<K>> keyView() const = 0;
+
+    /**
+     * @brief Getter for value of the element currently pointed at, without
+     * copying it.
+     * @return value if isValid(), valid until cursor is moved or map is
+     * modified
+     */
+    virtual std::optional<View<V>> valueView() const = 0;
   };
 
 }  // namespace jam::storage::face
@@ -6,6 +6,10 @@
 
 #pragma once
 
+#include <optional>
+#include <span>
+#include <vector>
+
 #include <qtils/outcome.hpp>
 
 #include "storage/face/owned_or_view.hpp"
@@ -44,5 +48,22 @@ namespace jam::storage::face {
      */
     [[nodiscard]] virtual outcome::result<std::optional<OwnedOrView<V>>> tryGet(
         const View<K> &key) const = 0;
+
+    /**
+     * @brief Get values of several keys at once
+     * @param keys keys to look up
+     * @return V or std::nullopt for each of keys, in the same order
+     */
+    [[nodiscard]] virtual outcome::result<
+        std::vector<std::optional<OwnedOrView<V>>>>
+    multiGet(std::span<const View<K>> keys) const {
+      std::vector<std::optional<OwnedOrView<V>>> values;
+      values.reserve(keys.size());
+      for (const auto &key : keys) {
+        OUTCOME_TRY(value, tryGet(key));
+        values.emplace_back(std::move(value));
+      }
+      return values;
+    }
   };
 }  // namespace jam::storage::face
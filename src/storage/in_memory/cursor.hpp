@@ -11,6 +11,10 @@
 #include "storage/in_memory/in_memory_storage.hpp"
 
 namespace jam::storage {
+  /**
+   * Cursor over entries in order of keys.
+   * Remembers only current key, so storage may be modified between moves.
+   */
   class InMemoryCursor : public BufferStorageCursor {
    public:
     explicit InMemoryCursor(InMemoryStorage &db) : db{db} {}
@@ -20,7 +24,7 @@ namespace jam::storage {
     }
 
     outcome::result<bool> seek(const ByteView &key) override {
-      return seek(db.storage_.lower_bound(key.toHex()));
+      return seek(db.storage_.lower_bound(key));
     }
 
     outcome::result<bool> seekLast() override {
@@ -29,46 +33,61 @@ namespace jam::storage {
     }
 
     bool isValid() const override {
-      return kv.has_value();
+      return key_.has_value();
     }
 
     outcome::result<void> next() override {
-      seek(db.storage_.upper_bound(kv->first.toHex()));
+      seek(db.storage_.upper_bound(*key_));
       return outcome::success();
     }
 
     outcome::result<void> prev() override {
-      auto it = db.storage_.lower_bound(kv->first.toHex());
+      auto it = db.storage_.lower_bound(*key_);
       seek(it == db.storage_.begin() ? db.storage_.end() : std::prev(it));
       return outcome::success();
     }
 
     std::optional<ByteVec> key() const override {
-      if (kv) {
-        return kv->first;
+      return key_;
+    }
+
+    std::optional<ByteVecOrView> value() const override {
+      if (key_) {
+        if (auto value = db.find(*key_)) {
+          return ByteView{*value};
+        }
       }
       return std::nullopt;
     }
 
-    std::optional<ByteVecOrView> value() const override {
-      if (kv) {
-        return ByteView{kv->second};
+    std::optional<ByteView> keyView() const override {
+      if (key_) {
+        return ByteView{*key_};
+      }
+      return std::nullopt;
+    }
+
+    std::optional<ByteView> valueView() const override {
+      if (key_) {
+        if (auto value = db.find(*key_)) {
+          return ByteView{*value};
+        }
       }
       return std::nullopt;
     }
 
    private:
-    bool seek(decltype(InMemoryStorage::storage_)::iterator it) {
+    bool seek(InMemoryStorage::Map::iterator it) {
       if (it == db.storage_.end()) {
-        kv.reset();
+        key_.reset();
       } else {
-        kv.emplace(ByteVec::fromHex(it->first).value(), it->second);
+        key_ = it->first;
       }
       return isValid();
     }
 
     // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
     InMemoryStorage &db;
-    std::optional<std::pair<ByteVec, ByteVec>> kv;
+    std::optional<ByteVec> key_;
   };
 }  // namespace jam::storage
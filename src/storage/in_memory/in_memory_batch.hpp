@@ -6,31 +6,43 @@
 
 #pragma once
 
+#include <map>
+#include <optional>
+
 #include <qtils/byte_vec.hpp>
-#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/buffer_map_types.hpp"
+#include "storage/bytes_compare.hpp"
 
 namespace jam::storage {
   using qtils::ByteVec;
 
+  /**
+   * Batch keeping changes in memory, which are applied to storage one by one
+   * on commit.
+   */
   class InMemoryBatch : public BufferBatch {
    public:
-    explicit InMemoryBatch(InMemoryStorage &db) : db{db} {}
+    explicit InMemoryBatch(BufferStorage &db) : db{db} {}
 
     outcome::result<void> put(const ByteView &key,
                               ByteVecOrView &&value) override {
-      entries[key.toHex()] = std::move(value).intoByteVec();
+      entries.insert_or_assign(ByteVec(key.begin(), key.end()),
+                               std::move(value).intoByteVec());
       return outcome::success();
     }
 
     outcome::result<void> remove(const ByteView &key) override {
-      entries.erase(key.toHex());
+      entries.insert_or_assign(ByteVec(key.begin(), key.end()), std::nullopt);
       return outcome::success();
     }
 
     outcome::result<void> commit() override {
-      for (auto &entry : entries) {
-        OUTCOME_TRY(db.put(ByteVec::fromHex(entry.first).value(),
-                           ByteView{entry.second}));
+      for (auto &[key, value] : entries) {
+        if (value) {
+          OUTCOME_TRY(db.put(key, ByteView{*value}));
+        } else {
+          OUTCOME_TRY(db.remove(key));
+        }
       }
       return outcome::success();
     }
@@ -40,8 +52,9 @@ namespace jam::storage {
     }
 
    private:
-    std::map<std::string, ByteVec> entries;
+    /// Removed keys are mapped to `std::nullopt`
+    std::map<ByteVec, std::optional<ByteVec>, BytesLess> entries;
     // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
-    InMemoryStorage &db;
+    BufferStorage &db;
   };
 }  // namespace jam::storage
@@ -0,0 +1,106 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <map>
+#include <optional>
+
+#include <qtils/byte_vec.hpp>
+
+#include "storage/buffer_map_types.hpp"
+#include "storage/bytes_compare.hpp"
+#include "storage/storage_error.hpp"
+
+namespace jam::storage {
+
+  /**
+   * Batch of changes of any storage, kept in ordered map for reads of own
+   * writes. Root batch reads through to storage and is committed by batch of
+   * storage; child batch reads through to parent and is committed into it.
+   */
+  class InMemoryIndexedBatch : public BufferIndexedBatch {
+   public:
+    InMemoryIndexedBatch(BufferStorage &db, InMemoryIndexedBatch *parent)
+        : db_{db}, parent_{parent} {}
+
+    outcome::result<bool> contains(const ByteView &key) const override {
+      OUTCOME_TRY(value, tryGet(key));
+      return value.has_value();
+    }
+
+    outcome::result<ByteVecOrView> get(const ByteView &key) const override {
+      OUTCOME_TRY(value, tryGet(key));
+      if (not value) {
+        return StorageError::NOT_FOUND;
+      }
+      return std::move(*value);
+    }
+
+    outcome::result<std::optional<ByteVecOrView>> tryGet(
+        const ByteView &key) const override {
+      if (auto it = entries_.find(key); it != entries_.end()) {
+        if (it->second) {
+          return std::make_optional(ByteVecOrView{ByteView{*it->second}});
+        }
+        return std::nullopt;
+      }
+      if (parent_) {
+        return parent_->tryGet(key);
+      }
+      return db_.tryGet(key);
+    }
+
+    outcome::result<void> put(const ByteView &key,
+                              ByteVecOrView &&value) override {
+      entries_.insert_or_assign(ByteVec(key.begin(), key.end()),
+                                std::move(value).intoByteVec());
+      return outcome::success();
+    }
+
+    outcome::result<void> remove(const ByteView &key) override {
+      entries_.insert_or_assign(ByteVec(key.begin(), key.end()), std::nullopt);
+      return outcome::success();
+    }
+
+    outcome::result<void> commit() override {
+      if (parent_) {
+        for (auto &[key, value] : entries_) {
+          if (value) {
+            OUTCOME_TRY(parent_->put(key, ByteView{*value}));
+          } else {
+            OUTCOME_TRY(parent_->remove(key));
+          }
+        }
+        return outcome::success();
+      }
+      auto batch = db_.batch();
+      for (auto &[key, value] : entries_) {
+        if (value) {
+          OUTCOME_TRY(batch->put(key, ByteView{*value}));
+        } else {
+          OUTCOME_TRY(batch->remove(key));
+        }
+      }
+      return batch->commit();
+    }
+
+    void clear() override {
+      entries_.clear();
+    }
+
+    std::unique_ptr<BufferIndexedBatch> child() override {
+      return std::make_unique<InMemoryIndexedBatch>(db_, this);
+    }
+
+   private:
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    BufferStorage &db_;
+    InMemoryIndexedBatch *parent_;
+    /// Removed keys are mapped to `std::nullopt`
+    std::map<ByteVec, std::optional<ByteVec>, BytesLess> entries_;
+  };
+}  // namespace jam::storage
@@ -15,14 +15,92 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <optional>
 
 #include "in_memory_storage.hpp"
 #include "storage/buffer_map_types.hpp"
+#include "storage/bytes_compare.hpp"
 #include "storage/spaced_storage.hpp"
 
 namespace jam::storage {
 
+  /**
+   * @class InMemorySnapshot
+   * @brief Snapshot of in-memory spaces, holding copies of them.
+   */
+  class InMemorySnapshot : public StorageSnapshot {
+   public:
+    explicit InMemorySnapshot(
+        std::map<Space, std::shared_ptr<InMemoryStorage>> spaces)
+        : spaces_{std::move(spaces)} {}
+
+    std::shared_ptr<BufferReadableStorage> getSpace(Space space) override {
+      auto it = spaces_.find(space);
+      if (it == spaces_.end()) {
+        // Space was not used before snapshot
+        it = spaces_.emplace(space, std::make_shared<InMemoryStorage>()).first;
+      }
+      return it->second;
+    }
+
+   private:
+    std::map<Space, std::shared_ptr<InMemoryStorage>> spaces_;
+  };
+
+  /**
+   * @class InMemorySpacedBatch
+   * @brief Changes of in-memory spaces, buffered per space and applied to
+   * them on commit.
+   *
+   * Writes to in-memory spaces can not fail, so commit is atomic.
+   */
+  class InMemorySpacedBatch : public SpacedBatch {
+   public:
+    explicit InMemorySpacedBatch(SpacedStorage &storage) : storage_{storage} {}
+
+    outcome::result<void> put(Space space,
+                              const ByteView &key,
+                              ByteVecOrView &&value) override {
+      changes_[space].insert_or_assign(ByteVec(key.begin(), key.end()),
+                                       std::move(value).intoByteVec());
+      return outcome::success();
+    }
+
+    outcome::result<void> remove(Space space, const ByteView &key) override {
+      changes_[space].insert_or_assign(ByteVec(key.begin(), key.end()),
+                                       std::nullopt);
+      return outcome::success();
+    }
+
+    /// In-memory spaces are not durable, so `sync` is ignored
+    outcome::result<void> commit(bool) override {
+      for (auto &[space, changes] : changes_) {
+        auto storage = storage_.getSpace(space);
+        for (auto &[key, value] : changes) {
+          if (value) {
+            OUTCOME_TRY(storage->put(key, ByteView{*value}));
+          } else {
+            OUTCOME_TRY(storage->remove(key));
+          }
+        }
+      }
+      return outcome::success();
+    }
+
+    void clear() override {
+      changes_.clear();
+    }
+
+   private:
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    SpacedStorage &storage_;
+    /// Removed keys are mapped to `std::nullopt`
+    std::map<Space, std::map<ByteVec, std::optional<ByteVec>, BytesLess>>
+        changes_;
+  };
+
   /**
    * @class InMemorySpacedStorage
    * @brief In-memory implementation of the SpacedStorage interface.
@@ -51,6 +129,35 @@ namespace jam::storage {
           .first->second;
     }
 
+    /**
+     * @brief Copy all spaces.
+     *
+     * Entries are copied one by one into new storages, as index of
+     * InMemoryStorage points into its own map and it can't be copied as is.
+     */
+    std::shared_ptr<StorageSnapshot> snapshot() override {
+      std::map<Space, std::shared_ptr<InMemoryStorage>> copies;
+      for (auto &[space, storage] : spaces_) {
+        auto copy = std::make_shared<InMemoryStorage>();
+        auto cursor = storage->cursor();
+        for (cursor->seekFirst().value(); cursor->isValid();
+             cursor->next().value()) {
+          copy->put(*cursor->keyView(), *cursor->valueView()).value();
+        }
+        copies.emplace(space, std::move(copy));
+      }
+      return std::make_shared<InMemorySnapshot>(std::move(copies));
+    }
+
+    std::unique_ptr<SpacedBatch> batch() override {
+      return std::make_unique<InMemorySpacedBatch>(*this);
+    }
+
+    /// In-memory spaces do not buffer changes
+    outcome::result<void> flush() override {
+      return outcome::success();
+    }
+
   private:
     /// Map of storage spaces to their corresponding in-memory storages
     std::map<Space, std::shared_ptr<InMemoryStorage>> spaces_;
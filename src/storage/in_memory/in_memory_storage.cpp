@@ -8,16 +8,25 @@
 
 #include "storage/in_memory/cursor.hpp"
 #include "storage/in_memory/in_memory_batch.hpp"
+#include "storage/in_memory/in_memory_indexed_batch.hpp"
 #include "storage/storage_error.hpp"
 
 using qtils::ByteVec;
 
 namespace jam::storage {
 
+  const ByteVec *InMemoryStorage::find(const ByteView &key) const {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      return nullptr;
+    }
+    return &it->second->second;
+  }
+
   outcome::result<ByteVecOrView> InMemoryStorage::get(
       const ByteView &key) const {
-    if (storage_.find(key.toHex()) != storage_.end()) {
-      return ByteView{storage_.at(key.toHex())};
+    if (auto value = find(key)) {
+      return ByteView{*value};
     }
 
     return StorageError::NOT_FOUND;
@@ -25,34 +34,57 @@ namespace jam::storage {
 
   outcome::result<std::optional<ByteVecOrView>> InMemoryStorage::tryGet(
       const qtils::ByteView &key) const {
-    if (storage_.find(key.toHex()) != storage_.end()) {
-      return ByteView{storage_.at(key.toHex())};
+    if (auto value = find(key)) {
+      return ByteView{*value};
     }
 
     return std::nullopt;
   }
 
+  outcome::result<std::vector<std::optional<ByteVecOrView>>>
+  InMemoryStorage::multiGet(std::span<const ByteView> keys) const {
+    std::vector<std::optional<ByteVecOrView>> values;
+    values.reserve(keys.size());
+    for (const auto &key : keys) {
+      if (auto value = find(key)) {
+        values.emplace_back(ByteView{*value});
+      } else {
+        values.emplace_back(std::nullopt);
+      }
+    }
+    return values;
+  }
+
   outcome::result<void> InMemoryStorage::put(const ByteView &key,
                                              ByteVecOrView &&value) {
-    auto it = storage_.find(key.toHex());
-    if (it != storage_.end()) {
-      size_t old_value_size = it->second.size();
-      BOOST_ASSERT(size_ >= old_value_size);
-      size_ -= old_value_size;
+    auto index_it = index_.find(key);
+    if (index_it != index_.end()) {
+      auto &old_value = index_it->second->second;
+      BOOST_ASSERT(size_ >= old_value.size());
+      size_ -= old_value.size();
+      size_ += value.size();
+      old_value = std::move(value).intoByteVec();
+      return outcome::success();
     }
     size_ += value.size();
-    storage_[key.toHex()] = std::move(value).intoByteVec();
+    auto it = storage_
+                  .emplace(ByteVec(key.begin(), key.end()),
+                           std::move(value).intoByteVec())
+                  .first;
+    index_.emplace(it->first, it);
     return outcome::success();
   }
 
   outcome::result<bool> InMemoryStorage::contains(const ByteView &key) const {
-    return storage_.find(key.toHex()) != storage_.end();
+    return index_.contains(key);
   }
 
   outcome::result<void> InMemoryStorage::remove(const ByteView &key) {
-    auto it = storage_.find(key.toHex());
-    if (it != storage_.end()) {
+    auto index_it = index_.find(key);
+    if (index_it != index_.end()) {
+      auto it = index_it->second;
       size_ -= it->second.size();
+      index_.erase(index_it);
       storage_.erase(it);
     }
     return outcome::success();
@@ -62,6 +94,10 @@ namespace jam::storage {
     return std::make_unique<InMemoryBatch>(*this);
   }
 
+  std::unique_ptr<BufferIndexedBatch> InMemoryStorage::indexedBatch() {
+    return std::make_unique<InMemoryIndexedBatch>(*this, nullptr);
+  }
+
   std::unique_ptr<InMemoryStorage::Cursor> InMemoryStorage::cursor() {
     return std::make_unique<InMemoryCursor>(*this);
   }
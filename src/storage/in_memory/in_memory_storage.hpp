@@ -6,12 +6,15 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <unordered_map>
 
 #include <qtils/byte_vec.hpp>
 #include <qtils/outcome.hpp>
 
 #include "storage/buffer_map_types.hpp"
+#include "storage/bytes_compare.hpp"
 
 namespace jam::storage {
 
@@ -19,6 +22,9 @@ namespace jam::storage {
    * Simple storage that conforms PersistentMap interface
    * Mostly needed to have an in-memory trie in tests to avoid integration with
    * an actual persistent database
+   *
+   * Entries are kept in ordered map keyed by bytes, for cursors, and point
+   * lookups go through hash index over the same keys, so neither allocates.
    */
   class InMemoryStorage : public BufferStorage {
    public:
@@ -30,6 +36,9 @@ namespace jam::storage {
     [[nodiscard]] outcome::result<std::optional<ByteVecOrView>> tryGet(
         const ByteView &key) const override;
 
+    [[nodiscard]] outcome::result<std::vector<std::optional<ByteVecOrView>>>
+    multiGet(std::span<const ByteView> keys) const override;
+
     outcome::result<void> put(const ByteView &key,
                               ByteVecOrView &&value) override;
 
@@ -40,12 +49,21 @@ namespace jam::storage {
 
     std::unique_ptr<BufferBatch> batch() override;
 
+    std::unique_ptr<BufferIndexedBatch> indexedBatch() override;
+
     std::unique_ptr<Cursor> cursor() override;
 
     [[nodiscard]] std::optional<size_t> byteSizeHint() const override;
 
    private:
-    std::map<std::string, ByteVec> storage_;
+    using Map = std::map<ByteVec, ByteVec, BytesLess>;
+
+    const ByteVec *find(const ByteView &key) const;
+
+    Map storage_;
+    /// Views of keys of `storage_`, whose nodes are never moved
+    std::unordered_map<qtils::BytesIn, Map::iterator, BytesHash, BytesEqual>
+        index_;
     size_t size_ = 0;
 
     friend class InMemoryCursor;
@@ -13,12 +13,18 @@
 #include <app/configuration.hpp>
 #include <qtils/cxx23/ranges/contains.hpp>
 #include <qtils/error_throw.hpp>
+#include <qtils/final_action.hpp>
 #include <rocksdb/filter_policy.h>
+#include <rocksdb/slice_transform.h>
 #include <rocksdb/table.h>
 #include <soralog/macro.hpp>
+#include <soralog/util.hpp>
 
+#include "storage/cached/cached_storage.hpp"
 #include "storage/rocksdb/rocksdb_batch.hpp"
 #include "storage/rocksdb/rocksdb_cursor.hpp"
+#include "storage/rocksdb/rocksdb_indexed_batch.hpp"
+#include "storage/rocksdb/rocksdb_metrics.hpp"
 #include "storage/rocksdb/rocksdb_spaces.hpp"
 #include "storage/rocksdb/rocksdb_util.hpp"
 #include "storage/storage_error.hpp"
@@ -27,14 +33,60 @@
 namespace jam::storage {
   namespace fs = std::filesystem;
 
-  rocksdb::ColumnFamilyOptions configureColumn(uint64_t memory_budget) {
+  std::shared_ptr<rocksdb::Cache> makeBlockCache(uint64_t capacity) {
+    // Zero estimated entry charge lets cache adapt to size of blocks
+    rocksdb::HyperClockCacheOptions options(capacity, 0);
+    return options.MakeSharedCache();
+  }
+
+  rocksdb::ColumnFamilyOptions configureColumn(
+      uint64_t memory_budget,
+      std::shared_ptr<rocksdb::Cache> block_cache,
+      size_t prefix_length) {
     rocksdb::ColumnFamilyOptions options;
     options.OptimizeLevelStyleCompaction(memory_budget);
-    auto table_options = RocksDb::tableOptionsConfiguration();
+    if (prefix_length > 0) {
+      // Bloom filters of tables and memtable index prefixes along with whole
+      // keys, for bounded iterators within one prefix
+      options.prefix_extractor.reset(
+          rocksdb::NewFixedPrefixTransform(prefix_length));
+      options.memtable_prefix_bloom_size_ratio = 0.1;
+    }
+    auto table_options =
+        RocksDb::tableOptionsConfiguration(std::move(block_cache));
     options.table_factory.reset(NewBlockBasedTableFactory(table_options));
     return options;
   }
 
+  /**
+   * Check that per-space option `option` names only spaces used by JAM.
+   * Unknown name (e.g. typo) would be silently ignored, while its cache
+   * share is still subtracted from shared cache.
+   */
+  template <typename Value>
+  bool checkSpaceNames(
+      const std::unordered_map<std::string, Value> &by_space_name,
+      std::string_view option,
+      log::Logger &log) {
+    bool valid = true;
+    for (const auto &[name, _] : by_space_name) {
+      const auto known = std::ranges::any_of(
+          std::views::iota(size_t{0}, SpacesCount), [&](size_t i) {
+            return spaceName(static_cast<Space>(i)) == name;
+          });
+      if (not known) {
+        SL_CRITICAL(log, "Unknown space '{}' in 'database.{}'", name, option);
+        valid = false;
+      }
+    }
+    return valid;
+  }
+
+  /**
+   * Spaces with reserved share of memory budget get own block cache of that
+   * size, other spaces share `shared_cache` of the rest of budget, so total
+   * size of caches is bounded by budget.
+   */
   template <std::ranges::range ColumnFamilyNames>
   void configureColumnFamilies(
       std::vector<rocksdb::ColumnFamilyDescriptor> &column_family_descriptors,
@@ -42,7 +94,9 @@ namespace jam::storage {
       ColumnFamilyNames &&cf_names,
       const std::unordered_map<std::string, int32_t> &column_ttl,
       const std::unordered_map<std::string, double> &column_cache_sizes,
+      const std::unordered_map<std::string, size_t> &column_prefix_length,
       uint64_t memory_budget,
+      const std::shared_ptr<rocksdb::Cache> &shared_cache,
       log::Logger &log) {
     double distributed_cache_part = 0;
     size_t count = 0;
@@ -64,39 +118,72 @@ namespace jam::storage {
     for (auto &space_name : std::forward<ColumnFamilyNames>(cf_names)) {
       auto ttl = 0;
       auto cache_size = 0ull;
+      size_t prefix_length = 0;
+      auto block_cache = shared_cache;
       if (const auto it = column_ttl.find(space_name); it != column_ttl.end()) {
         ttl = it->second;
       }
       if (const auto it = column_cache_sizes.find(space_name);
           it != column_cache_sizes.end()) {
         cache_size = static_cast<double>(memory_budget) * it->second;
+        block_cache = makeBlockCache(cache_size);
       } else {
         cache_size = other_spaces_cache_size;
       }
-      auto column_options = configureColumn(cache_size);
+      if (const auto it = column_prefix_length.find(space_name);
+          it != column_prefix_length.end()) {
+        prefix_length = it->second;
+      }
+      auto column_options =
+          configureColumn(cache_size, block_cache, prefix_length);
       column_family_descriptors.emplace_back(space_name, column_options);
       ttls.push_back(ttl);
-      SL_DEBUG(
-          log,
-          "Column family '{}' configured with ttl={}sec, cache_size={:.0f}Mb",
-          space_name,
-          ttl,
-          static_cast<double>(cache_size) / 1024.0 / 1024.0);
+      SL_DEBUG(log,
+               "Column family '{}' configured with ttl={}sec, "
+               "cache_size={:.0f}Mb{}, prefix_length={}",
+               space_name,
+               ttl,
+               static_cast<double>(cache_size) / 1024.0 / 1024.0,
+               block_cache == shared_cache ? " (shared)" : "",
+               prefix_length);
     }
   }
 
   RocksDb::RocksDb(qtils::SharedRef<log::LoggingSystem> logsys,
                    qtils::SharedRef<app::Configuration> app_config)
       : logger_(logsys->getLogger("RocksDB", "storage")) {
-    ro_.fill_cache = false;
+    const auto &db_config = app_config->database();
+    const auto &path = db_config.directory;
+    cached_columns_ = db_config.cached_columns;
+
+    // All options are checked, to report every unknown name at once
+    bool valid_spaces = checkSpaceNames(
+        db_config.column_cache_size, "column_cache_size", logger_);
+    valid_spaces &=
+        checkSpaceNames(db_config.column_ttl, "column_ttl", logger_);
+    valid_spaces &=
+        checkSpaceNames(db_config.cached_columns, "cached_columns", logger_);
+    valid_spaces &= checkSpaceNames(
+        db_config.column_prefix_length, "column_prefix_length", logger_);
+    if (not valid_spaces) {
+      qtils::raise(StorageError::INVALID_ARGUMENT);
+    }
 
-    const auto &path = app_config->database().directory;
+    // Spaces without reserved share of cache get the rest of budget
+    double reserved_cache_part = 0;
+    for (const auto &[_, part] : db_config.column_cache_size) {
+      reserved_cache_part += part;
+    }
+    block_cache_ = makeBlockCache(static_cast<double>(db_config.cache_size)
+                                  * std::max(0.0, 1.0 - reserved_cache_part));
 
     auto options = rocksdb::Options{};
     options.create_if_missing = true;
     options.optimize_filters_for_hits = true;
+    statistics_ = rocksdb::CreateDBStatistics();
+    options.statistics = statistics_;
     options.table_factory.reset(rocksdb::NewBlockBasedTableFactory(
-        storage::RocksDb::tableOptionsConfiguration()));
+        storage::RocksDb::tableOptionsConfiguration(block_cache_)));
 
     // Setting limit for open rocksdb files to a half of system soft limit
     auto soft_limit = getFdLimit(logger_);
@@ -154,38 +241,25 @@ namespace jam::storage {
       }
     }
 
-    const std::unordered_map<std::string, int32_t> column_ttl = {
-        // Example:
-        // {"avaliability_storage", 25 * 60 * 60}  // 25 hours
-    };
-
-    const std::unordered_map<std::string, double> column_cache_size = {
-        // Example:
-        // {"trie_node", 0.9}  // 90%
-    };
-
-    const auto memory_budget = app_config->database().cache_size;
-
     std::vector<rocksdb::ColumnFamilyDescriptor> column_family_descriptors;
     std::vector<int32_t> ttls;
     configureColumnFamilies(column_family_descriptors,
                             ttls,
                             all_families,
-                            column_ttl,
-                            column_cache_size,
-                            memory_budget,
+                            db_config.column_ttl,
+                            db_config.column_cache_size,
+                            db_config.column_prefix_length,
+                            db_config.cache_size,
+                            block_cache_,
                             logger_);
 
     options.create_missing_column_families = true;
 
     if (no_db_presented) {
-      qtils::raise_on_err(openDatabaseWithTTL(options,
-                                              path,
-                                              column_family_descriptors,
-                                              ttls,
-                                              *this,
-                                              logger_));
+      SL_INFO(logger_, "Creating new database in {}", path.native());
     }
+    qtils::raise_on_err(openDatabaseWithTTL(
+        options, path, column_family_descriptors, ttls, *this, logger_));
 
     // Print size of each column family
     SL_VERBOSE(logger_, "Current column family sizes:");
@@ -202,9 +276,36 @@ namespace jam::storage {
                 handle->GetName());
       }
     }
+
+    metrics_ = std::make_shared<RocksDbMetrics>(*this);
+    metrics::createRegistry()->registerCollector(metrics_);
+
+    if (db_config.wal_sync_interval.count() > 0) {
+      startWalSync(db_config.wal_sync_interval);
+    }
   }
 
   RocksDb::~RocksDb() {
+    // Spaces can not reach database through weak pointer anymore, so their
+    // buffered changes are written here
+    if (db_) {
+      if (auto res = flush(); res.has_error()) {
+        SL_ERROR(logger_,
+                 "Can't write buffered changes on close: {}",
+                 res.error());
+      }
+    }
+    if (metrics_) {
+      metrics_->detach();
+    }
+    if (wal_sync_thread_.joinable()) {
+      {
+        std::lock_guard lock{wal_sync_mutex_};
+        wal_sync_stop_ = true;
+      }
+      wal_sync_cv_.notify_one();
+      wal_sync_thread_.join();
+    }
     for (auto *handle : column_family_handles_) {
       db_->DestroyColumnFamilyHandle(handle);
     }
@@ -256,6 +357,7 @@ namespace jam::storage {
   }
 
   std::shared_ptr<BufferStorage> RocksDb::getSpace(Space space) {
+    std::lock_guard lock{spaces_mutex_};
     if (spaces_.contains(space)) {
       return spaces_[space];
     }
@@ -268,8 +370,13 @@ namespace jam::storage {
     if (column_family_handles_.end() == column) {
       throw StorageError::INVALID_ARGUMENT;
     }
-    auto space_ptr =
-        std::make_shared<RocksDbSpace>(weak_from_this(), *column, logger_);
+    std::shared_ptr<BufferStorage> space_ptr = std::make_shared<RocksDbSpace>(
+        weak_from_this(), *column, logger_, ro_);
+    if (auto it = cached_columns_.find(std::string(space_name));
+        it != cached_columns_.end()) {
+      space_ptr = std::make_shared<CachedStorage>(
+          std::move(space_ptr), it->second, it->first, logger_);
+    }
     spaces_[space] = space_ptr;
     return space_ptr;
   }
@@ -296,12 +403,110 @@ namespace jam::storage {
     e(db_->CreateColumnFamily({}, std::string(space_name), &handle));
   }
 
+  outcome::result<RocksDb::ColumnFamilyHandlePtr> RocksDb::column(
+      Space space) const {
+    auto space_name = spaceName(space);
+    auto column = std::ranges::find_if(
+        column_family_handles_,
+        [&space_name](const ColumnFamilyHandlePtr &handle) {
+          return handle->GetName() == space_name;
+        });
+    if (column_family_handles_.end() == column) {
+      return StorageError::INVALID_ARGUMENT;
+    }
+    return *column;
+  }
+
+  std::unique_ptr<SpacedBatch> RocksDb::batch() {
+    return std::make_unique<RocksDbSpacedBatch>(shared_from_this());
+  }
+
+  outcome::result<void> RocksDb::flush() {
+    rocksdb::WriteBatch batch;
+    return write(batch, {}, wo_);
+  }
+
+  bool RocksDb::cached(Space space) const {
+    return cached_columns_.contains(std::string(spaceName(space)));
+  }
+
+  outcome::result<void> RocksDb::write(rocksdb::WriteBatch &batch,
+                                       const CachedKeys &keys,
+                                       const rocksdb::WriteOptions &wo) {
+    // Buffered changes are added to batch only for this write
+    batch.SetSavePoint();
+    qtils::FinalAction rollback(
+        [&] { std::ignore = batch.RollbackToSavePoint(); });
+    static const CachedStorage::Keys kNone;
+    // Cached spaces are taken out of map, so that it is not locked during
+    // write; they are locked in order of spaces
+    std::vector<std::pair<Space, std::shared_ptr<CachedStorage>>> cached_spaces;
+    {
+      std::lock_guard lock{spaces_mutex_};
+      for (auto &[space, storage] : spaces_) {
+        if (auto cached = std::dynamic_pointer_cast<CachedStorage>(storage)) {
+          cached_spaces.emplace_back(space, std::move(cached));
+        }
+      }
+    }
+    std::vector<std::pair<CachedStorage::Commit, const CachedStorage::Keys *>>
+        commits;
+    for (auto &[space, cached] : cached_spaces) {
+      OUTCOME_TRY(handle, column(space));
+      auto it = keys.find(space);
+      const auto &replaced = it != keys.end() ? it->second : kNone;
+      auto &[commit, _] = commits.emplace_back(*cached, &replaced);
+      for (auto &[key, value] : commit.changes()) {
+        if (replaced.contains(key)) {
+          continue;
+        }
+        if (value) {
+          batch.Put(handle, make_slice(key), make_slice(*value));
+        } else {
+          batch.Delete(handle, make_slice(key));
+        }
+      }
+    }
+    if (batch.Count() == 0) {
+      return outcome::success();
+    }
+    auto status = db_->Write(wo, &batch);
+    if (not status.ok()) {
+      return status_as_error(status, logger_);
+    }
+    for (auto &[commit, replaced] : commits) {
+      commit.done(*replaced);
+    }
+    return outcome::success();
+  }
+
+  void RocksDb::startWalSync(std::chrono::milliseconds interval) {
+    wal_sync_thread_ = std::thread([this, interval] {
+      soralog::util::setThreadName("wal-sync");
+      std::unique_lock lock{wal_sync_mutex_};
+      while (not wal_sync_cv_.wait_for(
+          lock, interval, [this] { return wal_sync_stop_; })) {
+        if (db_) {
+          auto status = db_->SyncWAL();
+          if (not status.ok()) {
+            SL_ERROR(logger_, "Can't sync WAL: {}", status.ToString());
+          }
+        }
+      }
+    });
+  }
+
+  std::shared_ptr<StorageSnapshot> RocksDb::snapshot() {
+    // Snapshot of database does not see changes buffered by cached spaces
+    qtils::raise_on_err(flush());
+    return std::make_shared<RocksDbSnapshot>(shared_from_this());
+  }
+
   rocksdb::BlockBasedTableOptions RocksDb::tableOptionsConfiguration(
-      uint32_t lru_cache_size_mib, uint32_t block_size_kib) {
+      std::shared_ptr<rocksdb::Cache> block_cache, uint32_t block_size_kib) {
     rocksdb::BlockBasedTableOptions table_options;
     table_options.format_version = 5;
-    table_options.block_cache = rocksdb::NewLRUCache(
-        static_cast<uint64_t>(lru_cache_size_mib * 1024 * 1024));
+    table_options.block_cache = std::move(block_cache);
     table_options.block_size = static_cast<size_t>(block_size_kib * 1024);
     table_options.cache_index_and_filter_blocks = true;
     table_options.filter_policy.reset(rocksdb::NewBloomFilterPolicy(10, false));
@@ -355,17 +560,57 @@ namespace jam::storage {
     }
   }
 
+  RocksDbSnapshot::RocksDbSnapshot(std::shared_ptr<RocksDb> storage)
+      : storage_{std::move(storage)},
+        snapshot_{storage_->db_->GetSnapshot()} {
+    ro_ = storage_->ro_;
+    ro_.snapshot = snapshot_;
+  }
+
+  RocksDbSnapshot::~RocksDbSnapshot() {
+    storage_->db_->ReleaseSnapshot(snapshot_);
+  }
+
+  std::shared_ptr<BufferReadableStorage> RocksDbSnapshot::getSpace(
+      Space space) {
+    auto space_name = spaceName(space);
+    auto column = std::ranges::find_if(
+        storage_->column_family_handles_,
+        [&space_name](const RocksDb::ColumnFamilyHandlePtr &handle) {
+          return handle->GetName() == space_name;
+        });
+    if (storage_->column_family_handles_.end() == column) {
+      throw StorageError::INVALID_ARGUMENT;
+    }
+    // Space keeps snapshot alive
+    struct SnapshotSpace {
+      std::shared_ptr<RocksDbSnapshot> snapshot;
+      RocksDbSpace space;
+    };
+    auto holder = std::make_shared<SnapshotSpace>(SnapshotSpace{
+        .snapshot = shared_from_this(),
+        .space = RocksDbSpace{storage_, *column, storage_->logger_, ro_},
+    });
+    return {holder, &holder->space};
+  }
+
   RocksDbSpace::RocksDbSpace(std::weak_ptr<RocksDb> storage,
                              const RocksDb::ColumnFamilyHandlePtr &column,
-                             log::Logger logger)
-      : storage_{std::move(storage)},
+                             log::Logger logger,
+                             rocksdb::ReadOptions ro)
+      : logger_{std::move(logger)},
+        storage_{std::move(storage)},
         column_{column},
-        logger_{std::move(logger)} {}
+        ro_{ro} {}
 
   std::unique_ptr<BufferBatch> RocksDbSpace::batch() {
     return std::make_unique<RocksDbBatch>(*this, logger_);
   }
 
+  std::unique_ptr<BufferIndexedBatch> RocksDbSpace::indexedBatch() {
+    return std::make_unique<RocksDbIndexedBatch>(*this, nullptr);
+  }
+
   std::optional<size_t> RocksDbSpace::byteSizeHint() const {
     auto rocks = storage_.lock();
     if (!rocks) {
@@ -394,49 +639,75 @@ namespace jam::storage {
     if (!rocks) {
       throw StorageError::STORAGE_GONE;
     }
+    // Iterator must visit all keys even if space has prefix extractor,
+    // otherwise it would stop at the end of prefix of first sought key
+    auto ro = ro_;
+    ro.total_order_seek = true;
     auto it = std::unique_ptr<rocksdb::Iterator>(
-        rocks->db_->NewIterator(rocks->ro_, column_));
+        rocks->db_->NewIterator(ro, column_));
     return std::make_unique<RocksDBCursor>(std::move(it));
   }
 
-  outcome::result<bool> RocksDbSpace::contains(const ByteView &key) const {
-    OUTCOME_TRY(rocks, use());
-    std::string value;
-    auto status = rocks->db_->Get(rocks->ro_, column_, make_slice(key), &value);
-    if (status.ok()) {
-      return true;
+  std::unique_ptr<RocksDbSpace::Cursor> RocksDbSpace::rangeCursor(
+      const ByteView &lower, const std::optional<ByteView> &upper) {
+    auto rocks = storage_.lock();
+    if (!rocks) {
+      throw StorageError::STORAGE_GONE;
+    }
+    auto bounds = std::make_unique<RocksDBCursor::Bounds>(
+        ByteVec{lower.begin(), lower.end()},
+        upper ? std::make_optional(ByteVec{upper->begin(), upper->end()})
+              : std::nullopt);
+    auto ro = ro_;
+    ro.iterate_lower_bound = &bounds->lower_slice;
+    if (bounds->upper) {
+      ro.iterate_upper_bound = &bounds->upper_slice;
     }
+    ro.auto_prefix_mode = true;
+    auto it = std::unique_ptr<rocksdb::Iterator>(
+        rocks->db_->NewIterator(ro, column_));
+    return std::make_unique<RocksDBCursor>(std::move(it), std::move(bounds));
+  }
 
-    if (status.IsNotFound()) {
+  outcome::result<bool> RocksDbSpace::contains(const ByteView &key) const {
+    OUTCOME_TRY(rocks, use());
+    // Bloom filters rule out most absent keys without reading blocks. Value
+    // is not requested, so it is not copied out of memtable or block cache
+    if (not rocks->db_->KeyMayExist(
+            ro_, column_, make_slice(key), nullptr, nullptr)) {
       return false;
     }
-
-    return status_as_error(status, logger_);
+    OUTCOME_TRY(pinned, tryGetPinned(key));
+    return pinned.has_value();
   }
 
   outcome::result<ByteVecOrView> RocksDbSpace::get(const ByteView &key) const {
-    OUTCOME_TRY(rocks, use());
-    std::string value;
-    auto status = rocks->db_->Get(rocks->ro_, column_, make_slice(key), &value);
-    if (status.ok()) {
-      // cannot move string content to a buffer
-      return ByteVec(
-          reinterpret_cast<uint8_t *>(value.data()),                  // NOLINT
-          reinterpret_cast<uint8_t *>(value.data()) + value.size());  // NOLINT
+    OUTCOME_TRY(pinned, tryGetPinned(key));
+    if (not pinned) {
+      return StorageError::NOT_FOUND;
     }
-    return status_as_error(status, logger_);
+    auto view = pinned->view();
+    return ByteVec(view.begin(), view.end());
   }
 
   outcome::result<std::optional<ByteVecOrView>> RocksDbSpace::tryGet(
       const ByteView &key) const {
+    OUTCOME_TRY(pinned, tryGetPinned(key));
+    if (not pinned) {
+      return std::nullopt;
+    }
+    auto view = pinned->view();
+    return std::make_optional(ByteVecOrView(ByteVec(view.begin(), view.end())));
+  }
+
+  outcome::result<std::optional<RocksDbPinnedValue>>
+  RocksDbSpace::tryGetPinned(const ByteView &key) const {
     OUTCOME_TRY(rocks, use());
-    std::string value;
-    auto status = rocks->db_->Get(rocks->ro_, column_, make_slice(key), &value);
+    rocksdb::PinnableSlice value;
+    auto status = rocks->db_->Get(ro_, column_, make_slice(key), &value);
     if (status.ok()) {
-      auto buf = ByteVec(
-          reinterpret_cast<uint8_t *>(value.data()),                  // NOLINT
-          reinterpret_cast<uint8_t *>(value.data()) + value.size());  // NOLINT
-      return std::make_optional(ByteVecOrView(std::move(buf)));
+      return std::make_optional<RocksDbPinnedValue>(std::move(rocks),
+                                                    std::move(value));
     }
 
     if (status.IsNotFound()) {
@@ -446,6 +717,42 @@ namespace jam::storage {
     return status_as_error(status, logger_);
   }
 
+  outcome::result<std::vector<std::optional<ByteVecOrView>>>
+  RocksDbSpace::multiGet(std::span<const ByteView> keys) const {
+    OUTCOME_TRY(rocks, use());
+    std::vector<rocksdb::Slice> slices;
+    slices.reserve(keys.size());
+    for (const auto &key : keys) {
+      slices.emplace_back(make_slice(key));
+    }
+    std::vector<rocksdb::PinnableSlice> values(keys.size());
+    std::vector<rocksdb::Status> statuses(keys.size());
+    auto ro = ro_;
+    // Reads of keys from different files are issued concurrently, where
+    // rocksdb is built with io_uring support
+    ro.async_io = true;
+    ro.optimize_multiget_for_io = true;
+    rocks->db_->MultiGet(ro,
+                         column_,
+                         keys.size(),
+                         slices.data(),
+                         values.data(),
+                         statuses.data());
+
+    std::vector<std::optional<ByteVecOrView>> result;
+    result.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (statuses[i].ok()) {
+        result.emplace_back(make_buffer(values[i]));
+      } else if (statuses[i].IsNotFound()) {
+        result.emplace_back(std::nullopt);
+      } else {
+        return status_as_error(statuses[i], logger_);
+      }
+    }
+    return result;
+  }
+
   outcome::result<void> RocksDbSpace::put(const ByteView &key,
                                           ByteVecOrView &&value) {
     OUTCOME_TRY(rocks, use());
@@ -474,12 +781,14 @@ namespace jam::storage {
       return;
     }
     if (rocks->db_) {
+      auto ro = rocks->ro_;
+      ro.total_order_seek = true;
       std::unique_ptr<rocksdb::Iterator> begin(
-          rocks->db_->NewIterator(rocks->ro_, column_));
+          rocks->db_->NewIterator(ro, column_));
       first.empty() ? begin->SeekToFirst() : begin->Seek(make_slice(first));
       auto bk = begin->key();
       std::unique_ptr<rocksdb::Iterator> end(
-          rocks->db_->NewIterator(rocks->ro_, column_));
+          rocks->db_->NewIterator(ro, column_));
       last.empty() ? end->SeekToLast() : end->Seek(make_slice(last));
       auto ek = end->key();
       rocksdb::CompactRangeOptions options;
@@ -6,16 +6,25 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <filesystem>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
 
 #include <boost/container/flat_map.hpp>
 #include <qtils/shared_ref.hpp>
+#include <rocksdb/cache.h>
 #include <rocksdb/db.h>
+#include <rocksdb/statistics.h>
 #include <rocksdb/table.h>
 #include <rocksdb/utilities/db_ttl.h>
+#include <rocksdb/write_batch.h>
 
 #include "log/logger.hpp"
 #include "storage/buffer_map_types.hpp"
+#include "storage/bytes_compare.hpp"
 #include "storage/spaced_storage.hpp"
 #include "utils/ctor_limiters.hpp"
 
@@ -24,6 +33,7 @@ namespace jam::app {
 }
 
 namespace jam::storage {
+  class RocksDbMetrics;
 
   class RocksDb : public SpacedStorage,
                   public std::enable_shared_from_this<RocksDb>,
@@ -38,11 +48,22 @@ namespace jam::storage {
     ~RocksDb() override;
 
     static constexpr uint32_t kDefaultStateCacheSizeMiB = 512;
-    static constexpr uint32_t kDefaultLruCacheSizeMiB = 512;
     static constexpr uint32_t kDefaultBlockSizeKiB = 32;
 
+    /**
+     * Spaces listed in `database.cached_columns` of configuration are wrapped
+     * in `CachedStorage`, their writes reach database on its `commit` or on
+     * `flush` of database.
+     */
     std::shared_ptr<BufferStorage> getSpace(Space space) override;
 
+    std::shared_ptr<StorageSnapshot> snapshot() override;
+
+    std::unique_ptr<SpacedBatch> batch() override;
+
+    /// Commit buffered changes of all cached spaces in one write
+    outcome::result<void> flush() override;
+
     /**
      * Implementation-specific way to erase the whole space data.
      * Not exposed at SpacedStorage level as only used in pruner.
@@ -52,16 +73,20 @@ namespace jam::storage {
 
     /**
      * Prepare configuration structure
-     * @param lru_cache_size_mib - LRU rocksdb cache in MiB
+     * @param block_cache - rocksdb block cache, may be shared by columns
      * @param block_size_kib - internal rocksdb block size in KiB
      * @return options structure
      */
     static rocksdb::BlockBasedTableOptions tableOptionsConfiguration(
-        uint32_t lru_cache_size_mib = kDefaultLruCacheSizeMiB,
+        std::shared_ptr<rocksdb::Cache> block_cache,
         uint32_t block_size_kib = kDefaultBlockSizeKiB);
 
     friend class RocksDbSpace;
     friend class RocksDbBatch;
+    friend class RocksDbMetrics;
+    friend class RocksDbSnapshot;
+    friend class RocksDbSpacedBatch;
+    friend class RocksDbIndexedBatch;
 
    private:
     struct DatabaseGuard {
@@ -84,6 +109,28 @@ namespace jam::storage {
       log::Logger log_;
     };
 
+    /// Column family of space
+    outcome::result<ColumnFamilyHandlePtr> column(Space space) const;
+
+    /// Whether space is wrapped in `CachedStorage`
+    bool cached(Space space) const;
+
+    /// Keys changed by batch, by cached space
+    using CachedKeys = std::map<Space, std::set<ByteVec, BytesLess>>;
+
+    /**
+     * Write `batch` along with buffered changes of cached spaces in one
+     * write, so atomically. Changes of batch replace buffered changes of the
+     * same keys. Cached spaces are locked until their caches are updated.
+     * @param keys - keys changed by `batch` in cached spaces
+     */
+    outcome::result<void> write(rocksdb::WriteBatch &batch,
+                                const CachedKeys &keys,
+                                const rocksdb::WriteOptions &wo);
+
+    /// Sync write-ahead log periodically, until destruction
+    void startWalSync(std::chrono::milliseconds interval);
+
     static outcome::result<void> createDirectory(
         const std::filesystem::path &absolute_path, log::Logger &log);
 
@@ -96,28 +143,79 @@ namespace jam::storage {
         RocksDb &rocks_db,
         log::Logger &log);
 
+    /// Block cache of spaces without reserved share of cache
+    std::shared_ptr<rocksdb::Cache> block_cache_;
+    std::shared_ptr<rocksdb::Statistics> statistics_;
     rocksdb::DBWithTTL *db_{};
     std::vector<ColumnFamilyHandlePtr> column_family_handles_;
+    /// Guards `spaces_`, which are created on demand by any thread
+    std::mutex spaces_mutex_;
     boost::container::flat_map<Space, std::shared_ptr<BufferStorage>> spaces_;
+    /// Size of write-back cache by name of cached space
+    std::unordered_map<std::string, size_t> cached_columns_;
     rocksdb::ReadOptions ro_;
     rocksdb::WriteOptions wo_;
     log::Logger logger_;
+    std::shared_ptr<RocksDbMetrics> metrics_;
+
+    std::mutex wal_sync_mutex_;
+    std::condition_variable wal_sync_cv_;
+    bool wal_sync_stop_ = false;
+    std::thread wal_sync_thread_;
+  };
+
+  /**
+   * @brief Value read without copying.
+   *
+   * Points to block cache or memtable, which are pinned (and database is kept
+   * open) while instance is alive.
+   */
+  class RocksDbPinnedValue {
+   public:
+    RocksDbPinnedValue(std::shared_ptr<RocksDb> storage,
+                       rocksdb::PinnableSlice &&slice)
+        : storage_{std::move(storage)}, slice_{std::move(slice)} {}
+
+    ByteView view() const {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      return {reinterpret_cast<const uint8_t *>(slice_.data()), slice_.size()};
+    }
+
+   private:
+    std::shared_ptr<RocksDb> storage_;
+    rocksdb::PinnableSlice slice_;
   };
 
   class RocksDbSpace : public BufferStorage {
    public:
     ~RocksDbSpace() override = default;
 
+    /**
+     * @param ro - options of reads, e.g. with snapshot to read from
+     */
     RocksDbSpace(std::weak_ptr<RocksDb> storage,
                  const RocksDb::ColumnFamilyHandlePtr &column,
-                 log::Logger logger);
+                 log::Logger logger,
+                 rocksdb::ReadOptions ro);
 
     std::unique_ptr<BufferBatch> batch() override;
 
+    std::unique_ptr<BufferIndexedBatch> indexedBatch() override;
+
     std::optional<size_t> byteSizeHint() const override;
 
+    /// Iterator is in total order, regardless of prefix extractor of space
     std::unique_ptr<Cursor> cursor() override;
 
+    /**
+     * Iterator is bounded by `iterate_lower_bound` and `iterate_upper_bound`,
+     * so it skips data outside of range, and with `auto_prefix_mode` uses
+     * prefix bloom filters of space when range is within one prefix.
+     */
+    std::unique_ptr<Cursor> rangeCursor(
+        const ByteView &lower,
+        const std::optional<ByteView> &upper) override;
+
     outcome::result<bool> contains(const ByteView &key) const override;
 
     outcome::result<ByteVecOrView> get(const ByteView &key) const override;
@@ -125,6 +223,17 @@ namespace jam::storage {
     outcome::result<std::optional<ByteVecOrView>> tryGet(
         const ByteView &key) const override;
 
+    /**
+     * @brief Get value by key without copying it.
+     * @param key key to look up
+     * @return value pinned in database, or std::nullopt if key is absent
+     */
+    outcome::result<std::optional<RocksDbPinnedValue>> tryGetPinned(
+        const ByteView &key) const;
+
+    outcome::result<std::vector<std::optional<ByteVecOrView>>> multiGet(
+        std::span<const ByteView> keys) const override;
+
     outcome::result<void> put(const ByteView &key,
                               ByteVecOrView &&value) override;
 
@@ -133,6 +242,7 @@ namespace jam::storage {
     void compact(const ByteVec &first, const ByteVec &last);
 
     friend class RocksDbBatch;
+    friend class RocksDbIndexedBatch;
 
    private:
     // gather storage instance from weak ptr
@@ -142,5 +252,27 @@ namespace jam::storage {
     std::weak_ptr<RocksDb> storage_;
     // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
     const RocksDb::ColumnFamilyHandlePtr &column_;
+    rocksdb::ReadOptions ro_;
+  };
+
+  /**
+   * @brief Consistent read-only view of all spaces of RocksDb, pinned to
+   * `rocksdb::Snapshot` until it and all its spaces are released.
+   */
+  class RocksDbSnapshot : public StorageSnapshot,
+                          public std::enable_shared_from_this<RocksDbSnapshot>,
+                          NonCopyable,
+                          NonMovable {
+   public:
+    explicit RocksDbSnapshot(std::shared_ptr<RocksDb> storage);
+
+    ~RocksDbSnapshot() override;
+
+    std::shared_ptr<BufferReadableStorage> getSpace(Space space) override;
+
+   private:
+    std::shared_ptr<RocksDb> storage_;
+    const rocksdb::Snapshot *snapshot_;
+    rocksdb::ReadOptions ro_;
   };
 }  // namespace jam::storage
@@ -41,4 +41,39 @@ namespace jam::storage {
   void RocksDbBatch::clear() {
     batch_.Clear();
   }
+
+  RocksDbSpacedBatch::RocksDbSpacedBatch(std::shared_ptr<RocksDb> db)
+      : db_(std::move(db)) {}
+
+  outcome::result<void> RocksDbSpacedBatch::put(Space space,
+                                                const ByteView &key,
+                                                ByteVecOrView &&value) {
+    OUTCOME_TRY(column, db_->column(space));
+    batch_.Put(column, make_slice(key), make_slice(std::move(value)));
+    if (db_->cached(space)) {
+      cached_keys_[space].emplace(key.begin(), key.end());
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> RocksDbSpacedBatch::remove(Space space,
+                                                   const ByteView &key) {
+    OUTCOME_TRY(column, db_->column(space));
+    batch_.Delete(column, make_slice(key));
+    if (db_->cached(space)) {
+      cached_keys_[space].emplace(key.begin(), key.end());
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> RocksDbSpacedBatch::commit(bool sync) {
+    auto wo = db_->wo_;
+    wo.sync = sync;
+    return db_->write(batch_, cached_keys_, wo);
+  }
+
+  void RocksDbSpacedBatch::clear() {
+    batch_.Clear();
+    cached_keys_.clear();
+  }
 }  // namespace jam::storage
@@ -33,4 +33,31 @@ namespace jam::storage {
     log::Logger &logger_;
     rocksdb::WriteBatch batch_;
   };
+
+  /**
+   * Batch of changes of several spaces, written by one `DB::Write`, so
+   * atomically. Concurrent commits are coalesced by RocksDB write thread into
+   * one write (and one sync) of write-ahead log.
+   * Buffered changes of cached spaces are written along with batch, and
+   * their caches are updated by changes of batch.
+   */
+  class RocksDbSpacedBatch : public SpacedBatch {
+   public:
+    explicit RocksDbSpacedBatch(std::shared_ptr<RocksDb> db);
+
+    outcome::result<void> put(Space space,
+                              const ByteView &key,
+                              ByteVecOrView &&value) override;
+
+    outcome::result<void> remove(Space space, const ByteView &key) override;
+
+    outcome::result<void> commit(bool sync) override;
+
+    void clear() override;
+
+   private:
+    std::shared_ptr<RocksDb> db_;
+    rocksdb::WriteBatch batch_;
+    RocksDb::CachedKeys cached_keys_;
+  };
 }  // namespace jam::storage
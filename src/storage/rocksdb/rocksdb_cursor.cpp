@@ -10,8 +10,16 @@
 
 namespace jam::storage {
 
-  RocksDBCursor::RocksDBCursor(std::shared_ptr<rocksdb::Iterator> it)
-      : i_{std::move(it)} {}
+  RocksDBCursor::Bounds::Bounds(ByteVec lower, std::optional<ByteVec> upper)
+      : lower{std::move(lower)},
+        upper{std::move(upper)},
+        lower_slice{make_slice(this->lower)},
+        upper_slice{this->upper ? make_slice(*this->upper)
+                                : rocksdb::Slice{}} {}
+
+  RocksDBCursor::RocksDBCursor(std::shared_ptr<rocksdb::Iterator> it,
+                               std::unique_ptr<Bounds> bounds)
+      : bounds_{std::move(bounds)}, i_{std::move(it)} {}
 
   outcome::result<bool> RocksDBCursor::seekFirst() {
     i_->SeekToFirst();
@@ -51,4 +59,13 @@ namespace jam::storage {
     return isValid() ? std::make_optional(make_buffer(i_->value()))
                      : std::nullopt;
   }
+
+  std::optional<ByteView> RocksDBCursor::keyView() const {
+    return isValid() ? std::make_optional(make_span(i_->key())) : std::nullopt;
+  }
+
+  std::optional<ByteView> RocksDBCursor::valueView() const {
+    return isValid() ? std::make_optional(make_span(i_->value()))
+                     : std::nullopt;
+  }
 }  // namespace jam::storage
@@ -13,9 +13,25 @@ namespace jam::storage {
 
   class RocksDBCursor : public BufferStorageCursor {
    public:
+    /**
+     * Bounds of iteration, referenced by `rocksdb::ReadOptions` of iterator,
+     * so they are kept by cursor for lifetime of iterator.
+     */
+    struct Bounds {
+      Bounds(ByteVec lower, std::optional<ByteVec> upper);
+      Bounds(const Bounds &) = delete;
+      Bounds &operator=(const Bounds &) = delete;
+
+      ByteVec lower;
+      std::optional<ByteVec> upper;
+      rocksdb::Slice lower_slice;
+      rocksdb::Slice upper_slice;
+    };
+
     ~RocksDBCursor() override = default;
 
-    explicit RocksDBCursor(std::shared_ptr<rocksdb::Iterator> it);
+    explicit RocksDBCursor(std::shared_ptr<rocksdb::Iterator> it,
+                           std::unique_ptr<Bounds> bounds = nullptr);
 
     outcome::result<bool> seekFirst() override;
 
@@ -33,7 +49,13 @@ namespace jam::storage {
 
     std::optional<ByteVecOrView> value() const override;
 
+    std::optional<ByteView> keyView() const override;
+
+    std::optional<ByteView> valueView() const override;
+
    private:
+    // Destroyed after iterator
+    std::unique_ptr<Bounds> bounds_;
     std::shared_ptr<rocksdb::Iterator> i_;
   };
 
@@ -0,0 +1,103 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/rocksdb/rocksdb_indexed_batch.hpp"
+
+#include "storage/rocksdb/rocksdb_util.hpp"
+#include "storage/storage_error.hpp"
+
+namespace jam::storage {
+
+  RocksDbIndexedBatch::RocksDbIndexedBatch(RocksDbSpace &space,
+                                           RocksDbIndexedBatch *parent)
+      // Only latest entry of key is kept
+      : space_(space),
+        parent_(parent),
+        batch_(rocksdb::BytewiseComparator(), 0, true) {}
+
+  outcome::result<bool> RocksDbIndexedBatch::contains(
+      const ByteView &key) const {
+    OUTCOME_TRY(value, tryGet(key));
+    return value.has_value();
+  }
+
+  outcome::result<ByteVecOrView> RocksDbIndexedBatch::get(
+      const ByteView &key) const {
+    OUTCOME_TRY(value, tryGet(key));
+    if (not value) {
+      return StorageError::NOT_FOUND;
+    }
+    return std::move(*value);
+  }
+
+  outcome::result<std::optional<ByteVecOrView>> RocksDbIndexedBatch::tryGet(
+      const ByteView &key) const {
+    std::string value;
+    auto status =
+        batch_.GetFromBatch(space_.column_, {}, make_slice(key), &value);
+    if (status.ok()) {
+      return std::make_optional(ByteVecOrView(make_buffer(value)));
+    }
+    if (not status.IsNotFound()) {
+      return status_as_error(status, space_.logger_);
+    }
+    if (removed_.contains(key)) {
+      return std::nullopt;
+    }
+    if (parent_) {
+      return parent_->tryGet(key);
+    }
+    return space_.tryGet(key);
+  }
+
+  outcome::result<void> RocksDbIndexedBatch::put(const ByteView &key,
+                                                 ByteVecOrView &&value) {
+    batch_.Put(space_.column_, make_slice(key), make_slice(std::move(value)));
+    if (auto it = removed_.find(key); it != removed_.end()) {
+      removed_.erase(it);
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> RocksDbIndexedBatch::remove(const ByteView &key) {
+    batch_.Delete(space_.column_, make_slice(key));
+    removed_.emplace(key.begin(), key.end());
+    return outcome::success();
+  }
+
+  outcome::result<void> RocksDbIndexedBatch::commit() {
+    if (parent_) {
+      std::unique_ptr<rocksdb::WBWIIterator> it(
+          batch_.NewIterator(space_.column_));
+      for (it->SeekToFirst(); it->Valid(); it->Next()) {
+        auto entry = it->Entry();
+        if (entry.type == rocksdb::kPutRecord) {
+          OUTCOME_TRY(parent_->put(make_span(entry.key),
+                                   make_buffer(entry.value)));
+        } else {
+          OUTCOME_TRY(parent_->remove(make_span(entry.key)));
+        }
+      }
+      return outcome::success();
+    }
+    OUTCOME_TRY(rocks, space_.use());
+    auto status = rocks->db_->Write(rocks->wo_, batch_.GetWriteBatch());
+    if (status.ok()) {
+      return outcome::success();
+    }
+
+    return status_as_error(status, space_.logger_);
+  }
+
+  void RocksDbIndexedBatch::clear() {
+    batch_.Clear();
+    removed_.clear();
+  }
+
+  std::unique_ptr<BufferIndexedBatch> RocksDbIndexedBatch::child() {
+    return std::make_unique<RocksDbIndexedBatch>(space_, this);
+  }
+}  // namespace jam::storage
@@ -0,0 +1,61 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <set>
+
+#include <rocksdb/utilities/write_batch_with_index.h>
+
+#include "storage/bytes_compare.hpp"
+#include "storage/rocksdb/rocksdb.hpp"
+
+namespace jam::storage {
+
+  /**
+   * Batch of changes of one space, indexed by `rocksdb::WriteBatchWithIndex`
+   * for reads of own writes. Root batch reads through to database and is
+   * written by one `DB::Write`; child batch reads through to parent and is
+   * committed into it.
+   *
+   * `GetFromBatchAndDB` is not used, as it reads root database, bypassing
+   * TTL wrapper which strips timestamps of values. `GetFromBatch` does not
+   * tell removed keys from unknown ones, so removed keys are kept aside.
+   */
+  class RocksDbIndexedBatch : public BufferIndexedBatch {
+   public:
+    RocksDbIndexedBatch(RocksDbSpace &space, RocksDbIndexedBatch *parent);
+
+    ~RocksDbIndexedBatch() override = default;
+
+    outcome::result<bool> contains(const ByteView &key) const override;
+
+    outcome::result<ByteVecOrView> get(const ByteView &key) const override;
+
+    outcome::result<std::optional<ByteVecOrView>> tryGet(
+        const ByteView &key) const override;
+
+    outcome::result<void> put(const ByteView &key,
+                              ByteVecOrView &&value) override;
+
+    outcome::result<void> remove(const ByteView &key) override;
+
+    outcome::result<void> commit() override;
+
+    void clear() override;
+
+    std::unique_ptr<BufferIndexedBatch> child() override;
+
+   private:
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    RocksDbSpace &space_;
+    RocksDbIndexedBatch *parent_;
+    /// `GetFromBatch` is not const, but does not modify batch
+    mutable rocksdb::WriteBatchWithIndex batch_;
+    /// Keys whose latest change in `batch_` is removal
+    std::set<ByteVec, BytesLess> removed_;
+  };
+}  // namespace jam::storage
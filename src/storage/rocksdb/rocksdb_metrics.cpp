@@ -0,0 +1,154 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/rocksdb/rocksdb_metrics.hpp"
+
+#include "metrics/registry.hpp"
+#include "storage/rocksdb/rocksdb.hpp"
+
+namespace jam::storage {
+  namespace {
+    constexpr auto kStorageSize = "jam_storage_size";
+    constexpr auto kSpaceSize = "jam_rocksdb_space_size";
+    constexpr auto kLiveDataSize = "jam_rocksdb_live_data_size";
+    constexpr auto kMemtableSize = "jam_rocksdb_memtable_size";
+    constexpr auto kPendingCompaction = "jam_rocksdb_pending_compaction_bytes";
+    constexpr auto kWriteStopped = "jam_rocksdb_write_stopped";
+    constexpr auto kBlockCacheHit = "jam_rocksdb_block_cache_hit_total";
+    constexpr auto kBlockCacheMiss = "jam_rocksdb_block_cache_miss_total";
+    constexpr auto kStall = "jam_rocksdb_write_stall_microseconds_total";
+    constexpr auto kGetLatency = "jam_rocksdb_get_latency_microseconds";
+    constexpr auto kWriteLatency = "jam_rocksdb_write_latency_microseconds";
+  }  // namespace
+
+  RocksDbMetrics::RocksDbMetrics(RocksDb &rocks)
+      : rocks_{&rocks}, registry_{metrics::createRegistry()} {
+    registry_->registerGaugeFamily(
+        kStorageSize, "Size of storage: SST files on disk and memtables");
+    storage_size_ = registry_->registerGaugeMetric(kStorageSize);
+
+    registry_->registerGaugeFamily(
+        kSpaceSize, "Size of SST files and memtables of space");
+    registry_->registerGaugeFamily(kLiveDataSize,
+                                   "Estimated size of live data of space");
+    registry_->registerGaugeFamily(kMemtableSize,
+                                   "Size of memtables of space");
+    registry_->registerGaugeFamily(
+        kPendingCompaction,
+        "Estimated bytes to be rewritten by compaction of space");
+    for (auto *handle : rocks.column_family_handles_) {
+      const std::map<std::string, std::string> labels{
+          {"space", handle->GetName()}};
+      spaces_.emplace(
+          handle->GetName(),
+          SpaceMetrics{
+              .size = registry_->registerGaugeMetric(kSpaceSize, labels),
+              .live_data_size =
+                  registry_->registerGaugeMetric(kLiveDataSize, labels),
+              .memtable_size =
+                  registry_->registerGaugeMetric(kMemtableSize, labels),
+              .pending_compaction_bytes =
+                  registry_->registerGaugeMetric(kPendingCompaction, labels),
+          });
+    }
+
+    registry_->registerGaugeFamily(kWriteStopped,
+                                   "Whether writes are stopped by RocksDB");
+    write_stopped_ = registry_->registerGaugeMetric(kWriteStopped);
+
+    registry_->registerCounterFamily(kBlockCacheHit, "Block cache hits");
+    registry_->registerCounterFamily(kBlockCacheMiss, "Block cache misses");
+    registry_->registerCounterFamily(kStall, "Time writes were stalled");
+    tickers_ = {{
+        {rocksdb::BLOCK_CACHE_HIT,
+         registry_->registerCounterMetric(kBlockCacheHit)},
+        {rocksdb::BLOCK_CACHE_MISS,
+         registry_->registerCounterMetric(kBlockCacheMiss)},
+        {rocksdb::STALL_MICROS, registry_->registerCounterMetric(kStall)},
+    }};
+
+    registry_->registerGaugeFamily(kGetLatency, "Latency of reads");
+    registry_->registerGaugeFamily(kWriteLatency, "Latency of writes");
+    auto quantiles = [&](const char *name) {
+      return std::array{
+          registry_->registerGaugeMetric(name, {{"quantile", "0.5"}}),
+          registry_->registerGaugeMetric(name, {{"quantile", "0.95"}}),
+          registry_->registerGaugeMetric(name, {{"quantile", "0.99"}}),
+      };
+    };
+    latencies_ = {{
+        {rocksdb::DB_GET, quantiles(kGetLatency)},
+        {rocksdb::DB_WRITE, quantiles(kWriteLatency)},
+    }};
+  }
+
+  void RocksDbMetrics::detach() {
+    std::lock_guard lock{mutex_};
+    rocks_ = nullptr;
+  }
+
+  void RocksDbMetrics::collect() {
+    std::lock_guard lock{mutex_};
+    if (not rocks_ or not rocks_->db_) {
+      return;
+    }
+    auto &db = *rocks_->db_;
+
+    uint64_t total_size = 0;
+    for (auto *handle : rocks_->column_family_handles_) {
+      auto it = spaces_.find(handle->GetName());
+      if (it == spaces_.end()) {
+        continue;
+      }
+      auto &space = it->second;
+      // Properties are kept up to date by RocksDB, reading them does not
+      // touch data, unlike approximation of size of key range
+      uint64_t sst_size = 0;
+      uint64_t memtable_size = 0;
+      db.GetIntProperty(
+          handle, rocksdb::DB::Properties::kTotalSstFilesSize, &sst_size);
+      db.GetIntProperty(handle,
+                        rocksdb::DB::Properties::kCurSizeAllMemTables,
+                        &memtable_size);
+      total_size += sst_size + memtable_size;
+      space.size->set(sst_size + memtable_size);
+      space.memtable_size->set(memtable_size);
+      uint64_t value = 0;
+      if (db.GetIntProperty(
+              handle, rocksdb::DB::Properties::kEstimateLiveDataSize, &value)) {
+        space.live_data_size->set(value);
+      }
+      if (db.GetIntProperty(
+              handle,
+              rocksdb::DB::Properties::kEstimatePendingCompactionBytes,
+              &value)) {
+        space.pending_compaction_bytes->set(value);
+      }
+    }
+    storage_size_->set(total_size);
+
+    uint64_t stopped = 0;
+    if (db.GetIntProperty(rocksdb::DB::Properties::kIsWriteStopped, &stopped)) {
+      write_stopped_->set(stopped);
+    }
+
+    auto &statistics = *rocks_->statistics_;
+    for (auto &ticker : tickers_) {
+      auto value = statistics.getTickerCount(ticker.ticker);
+      if (value > ticker.last) {
+        ticker.counter->inc(static_cast<double>(value - ticker.last));
+      }
+      ticker.last = value;
+    }
+    for (auto &latency : latencies_) {
+      rocksdb::HistogramData data;
+      statistics.histogramData(latency.histogram, &data);
+      latency.quantiles[0]->set(data.median);
+      latency.quantiles[1]->set(data.percentile95);
+      latency.quantiles[2]->set(data.percentile99);
+    }
+  }
+}  // namespace jam::storage
@@ -0,0 +1,66 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <rocksdb/statistics.h>
+
+#include "metrics/metrics.hpp"
+
+namespace jam::storage {
+  class RocksDb;
+
+  /**
+   * @brief Exposes RocksDB statistics and properties of column families
+   * (spaces) as metrics, read from database on each scrape.
+   */
+  class RocksDbMetrics : public metrics::Collector {
+   public:
+    explicit RocksDbMetrics(RocksDb &rocks);
+
+    /**
+     * @brief stop reading database, must be called before it is closed
+     */
+    void detach();
+
+    void collect() override;
+
+   private:
+    struct SpaceMetrics {
+      metrics::Gauge *size;
+      metrics::Gauge *live_data_size;
+      metrics::Gauge *memtable_size;
+      metrics::Gauge *pending_compaction_bytes;
+    };
+
+    // Monotonic statistics ticker, exposed as counter
+    struct Ticker {
+      rocksdb::Tickers ticker;
+      metrics::Counter *counter;
+      uint64_t last = 0;
+    };
+
+    // Quantiles of statistics histogram, exposed as gauges
+    struct Latency {
+      rocksdb::Histograms histogram;
+      std::array<metrics::Gauge *, 3> quantiles;
+    };
+
+    std::mutex mutex_;
+    RocksDb *rocks_;
+    std::unique_ptr<metrics::Registry> registry_;
+    std::unordered_map<std::string, SpaceMetrics> spaces_;
+    metrics::Gauge *storage_size_;
+    metrics::Gauge *write_stopped_;
+    std::array<Ticker, 3> tickers_;
+    std::array<Latency, 2> latencies_;
+  };
+}  // namespace jam::storage
@@ -17,11 +17,59 @@
 
 #include <memory>
 
+#include <qtils/outcome.hpp>
+
 #include "storage/buffer_map_types.hpp"
 #include "storage/spaces.hpp"
 
 namespace jam::storage {
 
+  /**
+   * @class SpacedBatch
+   * @brief Changes of several storage spaces, applied atomically on commit.
+   */
+  class SpacedBatch {
+   public:
+    virtual ~SpacedBatch() = default;
+
+    virtual outcome::result<void> put(Space space,
+                                      const ByteView &key,
+                                      ByteVecOrView &&value) = 0;
+
+    virtual outcome::result<void> remove(Space space, const ByteView &key) = 0;
+
+    /**
+     * Apply all changes at once
+     * @param sync - whether changes must be durable on return (e.g. for
+     * finalized block), otherwise they are durable after next sync of
+     * storage
+     */
+    virtual outcome::result<void> commit(bool sync = false) = 0;
+
+    virtual void clear() = 0;
+  };
+
+  /**
+   * @class StorageSnapshot
+   * @brief Read-only view of all storage spaces as of moment of its creation.
+   *
+   * Writes made after snapshot was taken are not visible through it, so
+   * readers holding snapshot see consistent state while storage is modified
+   * concurrently.
+   */
+  class StorageSnapshot {
+   public:
+    virtual ~StorageSnapshot() = default;
+
+    /**
+     * Retrieve a pointer to the read-only map of particular storage space
+     * @param space - identifier of required space
+     * @return a pointer to read-only buffer storage for a space, which keeps
+     * snapshot alive
+     */
+    virtual std::shared_ptr<BufferReadableStorage> getSpace(Space space) = 0;
+  };
+
   /**
    * @class SpacedStorage
    * @brief Abstract interface for accessing different logical storage spaces.
@@ -41,6 +89,26 @@ namespace jam::storage {
      * @return a pointer buffer storage for a space
      */
     virtual std::shared_ptr<BufferStorage> getSpace(Space space) = 0;
+
+    /**
+     * Take consistent read-only view of all spaces.
+     * Changes buffered by spaces are flushed first, so they are seen by
+     * snapshot.
+     * @return snapshot of current state of storage
+     */
+    virtual std::shared_ptr<StorageSnapshot> snapshot() = 0;
+
+    /**
+     * Create batch of changes of any spaces
+     * @return batch, which is committed atomically
+     */
+    virtual std::unique_ptr<SpacedBatch> batch() = 0;
+
+    /**
+     * Write changes buffered by spaces (e.g. by write-back caches) to
+     * storage. Done on destruction of storage as well.
+     */
+    virtual outcome::result<void> flush() = 0;
   };
 
 }  // namespace jam::storage
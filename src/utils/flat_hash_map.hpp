@@ -0,0 +1,605 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * Open-addressing hash containers for keys which are already uniformly random
+ * bytes (hashes, public keys), e.g. `qtils::ByteArr<32>`.
+ * First 8 bytes of key are used as hash, so keys must not be chosen freely by
+ * untrusted party.
+ * Layout follows SwissTable: slots are stored inline in one flat array, and
+ * array of control bytes (7 bits of hash for occupied slot) is probed by
+ * groups of 16 with SIMD comparison.
+ */
+
+namespace jam {
+  namespace flat_hash {
+    template <typename Key>
+    concept RandomBytesKey = std::is_trivially_copyable_v<Key>
+                         and sizeof(Key) >= sizeof(uint64_t)
+                         and std::equality_comparable<Key>;
+
+    template <RandomBytesKey Key>
+    uint64_t hash(const Key &key) {
+      uint64_t h;
+      std::memcpy(&h, &key, sizeof(h));
+      return h;
+    }
+
+    /// Control byte: 7 bits of hash for occupied slot, or one of special
+    /// values with sign bit set
+    using Ctrl = int8_t;
+    constexpr Ctrl kEmpty = -128;
+    constexpr Ctrl kDeleted = -2;
+    constexpr size_t kGroupSize = 16;
+
+    /// Bit masks of control bytes of group matching condition
+    class Group {
+     public:
+      explicit Group(const Ctrl *ctrl) {
+#if defined(__SSE2__)
+        ctrl_ = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl));
+#else
+        std::memcpy(ctrl_, ctrl, kGroupSize);
+#endif
+      }
+
+      uint32_t match(Ctrl h2) const {
+#if defined(__SSE2__)
+        return static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+#else
+        return matchIf([h2](Ctrl c) { return c == h2; });
+#endif
+      }
+
+      uint32_t matchEmpty() const {
+        return match(kEmpty);
+      }
+
+      uint32_t matchEmptyOrDeleted() const {
+#if defined(__SSE2__)
+        return static_cast<uint32_t>(_mm_movemask_epi8(ctrl_));
+#else
+        return matchIf([](Ctrl c) { return c < 0; });
+#endif
+      }
+
+     private:
+#if defined(__SSE2__)
+      __m128i ctrl_;
+#else
+      uint32_t matchIf(auto &&f) const {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < kGroupSize; ++i) {
+          mask |= static_cast<uint32_t>(f(ctrl_[i])) << i;
+        }
+        return mask;
+      }
+
+      Ctrl ctrl_[kGroupSize];
+#endif
+    };
+
+    /**
+     * Table of `Slot`s, each containing key returned by `KeyOf`.
+     * Load factor (including deleted slots) is kept below 7/8, so probing
+     * always reaches group with empty slot.
+     */
+    template <typename Key, typename Slot, typename KeyOf, typename Allocator>
+    class Table {
+      using AllocTraits = std::allocator_traits<Allocator>;
+      using SlotAlloc = typename AllocTraits::template rebind_alloc<Slot>;
+      using SlotTraits = std::allocator_traits<SlotAlloc>;
+      using CtrlAlloc = typename AllocTraits::template rebind_alloc<Ctrl>;
+      using CtrlTraits = std::allocator_traits<CtrlAlloc>;
+
+      template <bool Const>
+      class Iterator {
+        using TablePtr = std::conditional_t<Const, const Table *, Table *>;
+        // Slot of set is its key, which must not be changed in place
+        static constexpr bool kConstSlot = Const or std::is_same_v<Slot, Key>;
+
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Slot;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<kConstSlot, const Slot *, Slot *>;
+        using reference = std::conditional_t<kConstSlot, const Slot &, Slot &>;
+
+        Iterator() = default;
+        Iterator(TablePtr table, size_t i) : table_{table}, i_{i} {
+          skip();
+        }
+        operator Iterator<true>() const {
+          return {table_, i_};
+        }
+
+        reference operator*() const {
+          return table_->slots_[i_];
+        }
+        pointer operator->() const {
+          return &table_->slots_[i_];
+        }
+        Iterator &operator++() {
+          ++i_;
+          skip();
+          return *this;
+        }
+        Iterator operator++(int) {
+          auto it = *this;
+          ++*this;
+          return it;
+        }
+        bool operator==(const Iterator &other) const {
+          return i_ == other.i_;
+        }
+
+       private:
+        friend Table;
+
+        void skip() {
+          while (i_ < table_->capacity_ and table_->ctrl_[i_] < 0) {
+            ++i_;
+          }
+        }
+
+        TablePtr table_ = nullptr;
+        size_t i_ = 0;
+      };
+
+     public:
+      using key_type = Key;
+      using value_type = Slot;
+      using size_type = size_t;
+      using allocator_type = Allocator;
+      using iterator = Iterator<false>;
+      using const_iterator = Iterator<true>;
+
+      Table() = default;
+
+      explicit Table(const Allocator &alloc) : alloc_{alloc} {}
+
+      Table(const Table &other)
+          : alloc_{SlotTraits::select_on_container_copy_construction(
+              other.alloc_)} {
+        copyFrom(other);
+      }
+
+      Table(Table &&other) noexcept : alloc_{other.alloc_} {
+        steal(other);
+      }
+
+      ~Table() {
+        destroy();
+      }
+
+      Table &operator=(const Table &other) {
+        if (this != &other) {
+          clear();
+          copyFrom(other);
+        }
+        return *this;
+      }
+
+      Table &operator=(Table &&other) noexcept(
+          SlotTraits::is_always_equal::value) {
+        if (this == &other) {
+          return *this;
+        }
+        if (alloc_ == other.alloc_) {
+          destroy();
+          steal(other);
+        } else {
+          // Storage can't be adopted from another memory resource
+          clear();
+          reserve(other.size_);
+          for (size_t i = 0; i < other.capacity_; ++i) {
+            if (other.ctrl_[i] >= 0) {
+              insertUnique(std::move(other.slots_[i]));
+            }
+          }
+          other.clear();
+        }
+        return *this;
+      }
+
+      allocator_type get_allocator() const {
+        return alloc_;
+      }
+
+      iterator begin() {
+        return {this, 0};
+      }
+      iterator end() {
+        return {this, capacity_};
+      }
+      const_iterator begin() const {
+        return {this, 0};
+      }
+      const_iterator end() const {
+        return {this, capacity_};
+      }
+
+      size_t size() const {
+        return size_;
+      }
+      bool empty() const {
+        return size_ == 0;
+      }
+      size_t capacity() const {
+        return capacity_;
+      }
+
+      iterator find(const Key &key) {
+        return {this, findIndex(key)};
+      }
+      const_iterator find(const Key &key) const {
+        return {this, findIndex(key)};
+      }
+      bool contains(const Key &key) const {
+        return findIndex(key) != capacity_;
+      }
+      size_t count(const Key &key) const {
+        return contains(key) ? 1 : 0;
+      }
+
+      size_t erase(const Key &key) {
+        auto i = findIndex(key);
+        if (i == capacity_) {
+          return 0;
+        }
+        eraseIndex(i);
+        return 1;
+      }
+
+      iterator erase(const_iterator it) {
+        eraseIndex(it.i_);
+        return {this, it.i_ + 1};
+      }
+
+      void clear() {
+        if (capacity_ == 0) {
+          return;
+        }
+        for (size_t i = 0; i < capacity_; ++i) {
+          if (ctrl_[i] >= 0) {
+            SlotTraits::destroy(alloc_, &slots_[i]);
+          }
+        }
+        std::fill_n(ctrl_, capacity_, kEmpty);
+        size_ = 0;
+        growth_left_ = maxLoad(capacity_);
+      }
+
+      /// Allocate space for `n` elements without rehashing
+      void reserve(size_t n) {
+        if (n > maxLoad(capacity_)) {
+          rehash(capacityFor(n));
+        }
+      }
+
+     protected:
+      /// Find slot with `key`, or construct one from `args` if none
+      template <typename... Args>
+      std::pair<iterator, bool> emplaceKey(const Key &key, Args &&...args) {
+        auto i = findIndex(key);
+        if (i != capacity_) {
+          return {{this, i}, false};
+        }
+        const auto h = hash(key);
+        i = prepareInsert(h);
+        SlotTraits::construct(alloc_, &slots_[i], std::forward<Args>(args)...);
+        ctrl_[i] = h2(h);
+        ++size_;
+        return {{this, i}, true};
+      }
+
+     private:
+      static Ctrl h2(uint64_t h) {
+        return static_cast<Ctrl>(h & 0x7f);
+      }
+
+      static size_t maxLoad(size_t capacity) {
+        return capacity - capacity / 8;
+      }
+
+      static size_t capacityFor(size_t n) {
+        return std::max(kGroupSize, std::bit_ceil(n + (n + 6) / 7));
+      }
+
+      /// Visit groups of probe sequence of hash until `f` returns true.
+      /// Triangular steps visit every group, as number of groups is power of 2.
+      template <typename F>
+      void probe(uint64_t h, F &&f) const {
+        const auto mask = capacity_ / kGroupSize - 1;
+        auto group = (h >> 7) & mask;
+        for (size_t step = 1;; ++step) {
+          if (f(group * kGroupSize)) {
+            return;
+          }
+          group = (group + step) & mask;
+        }
+      }
+
+      size_t findIndex(const Key &key) const {
+        if (size_ == 0) {
+          return capacity_;
+        }
+        const auto h = hash(key);
+        auto found = capacity_;
+        probe(h, [&](size_t offset) {
+          Group group{ctrl_ + offset};
+          for (auto m = group.match(h2(h)); m != 0; m &= m - 1) {
+            auto i = offset + std::countr_zero(m);
+            if (KeyOf{}(slots_[i]) == key) {
+              found = i;
+              return true;
+            }
+          }
+          return group.matchEmpty() != 0;
+        });
+        return found;
+      }
+
+      /// Index of free slot for hash, growing table if needed
+      size_t prepareInsert(uint64_t h) {
+        if (growth_left_ == 0) {
+          // Drop deleted slots in place if table is mostly tombstones
+          rehash(size_ < maxLoad(capacity_) / 2 ? capacity_
+                                                 : capacityFor(size_ + 1));
+        }
+        size_t i = 0;
+        probe(h, [&](size_t offset) {
+          auto m = Group{ctrl_ + offset}.matchEmptyOrDeleted();
+          if (m == 0) {
+            return false;
+          }
+          i = offset + std::countr_zero(m);
+          return true;
+        });
+        if (ctrl_[i] == kEmpty) {
+          --growth_left_;
+        }
+        return i;
+      }
+
+      void eraseIndex(size_t i) {
+        SlotTraits::destroy(alloc_, &slots_[i]);
+        --size_;
+        // Probing stops at group with empty slot, so if group already has one,
+        // no probe sequence continues past it and slot may become empty too
+        const auto offset = i / kGroupSize * kGroupSize;
+        if (Group{ctrl_ + offset}.matchEmpty() != 0) {
+          ctrl_[i] = kEmpty;
+          ++growth_left_;
+        } else {
+          ctrl_[i] = kDeleted;
+        }
+      }
+
+      /// Insert slot known to be absent
+      void insertUnique(Slot &&slot) {
+        const auto h = hash(KeyOf{}(slot));
+        auto i = prepareInsert(h);
+        SlotTraits::construct(alloc_, &slots_[i], std::move(slot));
+        ctrl_[i] = h2(h);
+        ++size_;
+      }
+
+      void rehash(size_t capacity) {
+        CtrlAlloc ctrl_alloc{alloc_};
+        auto old_ctrl = ctrl_;
+        auto old_slots = slots_;
+        auto old_capacity = capacity_;
+        slots_ = SlotTraits::allocate(alloc_, capacity);
+        ctrl_ = CtrlTraits::allocate(ctrl_alloc, capacity);
+        std::fill_n(ctrl_, capacity, kEmpty);
+        capacity_ = capacity;
+        size_ = 0;
+        growth_left_ = maxLoad(capacity);
+        for (size_t i = 0; i < old_capacity; ++i) {
+          if (old_ctrl[i] >= 0) {
+            insertUnique(std::move(old_slots[i]));
+            SlotTraits::destroy(alloc_, &old_slots[i]);
+          }
+        }
+        if (old_capacity != 0) {
+          SlotTraits::deallocate(alloc_, old_slots, old_capacity);
+          CtrlTraits::deallocate(ctrl_alloc, old_ctrl, old_capacity);
+        }
+      }
+
+      void copyFrom(const Table &other) {
+        reserve(other.size_);
+        for (auto &slot : other) {
+          const auto h = hash(KeyOf{}(slot));
+          auto i = prepareInsert(h);
+          SlotTraits::construct(alloc_, &slots_[i], slot);
+          ctrl_[i] = h2(h);
+          ++size_;
+        }
+      }
+
+      void steal(Table &other) {
+        ctrl_ = std::exchange(other.ctrl_, nullptr);
+        slots_ = std::exchange(other.slots_, nullptr);
+        capacity_ = std::exchange(other.capacity_, 0);
+        size_ = std::exchange(other.size_, 0);
+        growth_left_ = std::exchange(other.growth_left_, 0);
+      }
+
+      void destroy() {
+        if (capacity_ == 0) {
+          return;
+        }
+        clear();
+        CtrlAlloc ctrl_alloc{alloc_};
+        SlotTraits::deallocate(alloc_, slots_, capacity_);
+        CtrlTraits::deallocate(ctrl_alloc, ctrl_, capacity_);
+        ctrl_ = nullptr;
+        slots_ = nullptr;
+        capacity_ = 0;
+        growth_left_ = 0;
+      }
+
+      [[no_unique_address]] SlotAlloc alloc_{};
+      Ctrl *ctrl_ = nullptr;
+      Slot *slots_ = nullptr;
+      size_t capacity_ = 0;
+      size_t size_ = 0;
+      size_t growth_left_ = 0;
+    };
+
+    struct SetKeyOf {
+      const auto &operator()(const auto &key) const {
+        return key;
+      }
+    };
+
+    struct MapKeyOf {
+      const auto &operator()(const auto &pair) const {
+        return pair.first;
+      }
+    };
+  }  // namespace flat_hash
+
+  /**
+   * Flat hash map for uniformly random keys, e.g. `qtils::ByteArr<32>`.
+   * Iterators and references are invalidated by insertion.
+   */
+  template <flat_hash::RandomBytesKey Key,
+            typename Value,
+            typename Allocator = std::allocator<std::pair<const Key, Value>>>
+  class FlatHashMap
+      : public flat_hash::Table<Key,
+                                std::pair<const Key, Value>,
+                                flat_hash::MapKeyOf,
+                                Allocator> {
+    using Table = flat_hash::Table<Key,
+                                   std::pair<const Key, Value>,
+                                   flat_hash::MapKeyOf,
+                                   Allocator>;
+
+   public:
+    using mapped_type = Value;
+    using typename Table::const_iterator;
+    using typename Table::iterator;
+
+    using Table::Table;
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+      return this->emplaceKey(
+          key,
+          std::piecewise_construct,
+          std::forward_as_tuple(key),
+          std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <typename V>
+    std::pair<iterator, bool> emplace(const Key &key, V &&value) {
+      return try_emplace(key, std::forward<V>(value));
+    }
+
+    std::pair<iterator, bool> insert(const std::pair<const Key, Value> &pair) {
+      return try_emplace(pair.first, pair.second);
+    }
+
+    Value &operator[](const Key &key) {
+      return try_emplace(key).first->second;
+    }
+
+    Value &at(const Key &key) {
+      auto it = this->find(key);
+      if (it == this->end()) {
+        throw std::out_of_range{"FlatHashMap::at"};
+      }
+      return it->second;
+    }
+
+    const Value &at(const Key &key) const {
+      auto it = this->find(key);
+      if (it == this->end()) {
+        throw std::out_of_range{"FlatHashMap::at"};
+      }
+      return it->second;
+    }
+  };
+
+  /**
+   * Flat hash set for uniformly random keys, e.g. `qtils::ByteArr<32>`.
+   * Iterators and references are invalidated by insertion.
+   */
+  template <flat_hash::RandomBytesKey Key,
+            typename Allocator = std::allocator<Key>>
+  class FlatHashSet
+      : public flat_hash::Table<Key, Key, flat_hash::SetKeyOf, Allocator> {
+    using Table = flat_hash::Table<Key, Key, flat_hash::SetKeyOf, Allocator>;
+
+   public:
+    using typename Table::const_iterator;
+    using typename Table::iterator;
+
+    using Table::Table;
+
+    FlatHashSet(std::initializer_list<Key> keys,
+                const Allocator &alloc = Allocator{})
+        : FlatHashSet(keys.begin(), keys.end(), alloc) {}
+
+    template <std::input_iterator It>
+    FlatHashSet(It first, It last, const Allocator &alloc = Allocator{})
+        : Table{alloc} {
+      if constexpr (std::forward_iterator<It>) {
+        this->reserve(std::distance(first, last));
+      }
+      for (; first != last; ++first) {
+        insert(*first);
+      }
+    }
+
+    std::pair<iterator, bool> insert(const Key &key) {
+      return this->emplaceKey(key, key);
+    }
+
+    std::pair<iterator, bool> emplace(const Key &key) {
+      return insert(key);
+    }
+  };
+
+  namespace pmr {
+    template <typename Key, typename Value>
+    using FlatHashMap =
+        jam::FlatHashMap<Key,
+                         Value,
+                         std::pmr::polymorphic_allocator<
+                             std::pair<const Key, Value>>>;
+
+    template <typename Key>
+    using FlatHashSet =
+        jam::FlatHashSet<Key, std::pmr::polymorphic_allocator<Key>>;
+  }  // namespace pmr
+}  // namespace jam
@@ -0,0 +1,120 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <qtils/outcome.hpp>
+
+#include "utils/ctor_limiters.hpp"
+
+namespace jam {
+
+  /**
+   * Read-only memory mapping of whole file.
+   * Pages are loaded on access, so file may be much larger than RAM.
+   */
+  class MappedFile : NonCopyable {
+   public:
+    static outcome::result<MappedFile> open(const std::filesystem::path &path) {
+      auto errno_error = [] {
+        return std::error_code{errno, std::generic_category()};
+      };
+      auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd == -1) {
+        return errno_error();
+      }
+      struct stat st{};
+      if (fstat(fd, &st) == -1) {
+        auto error = errno_error();
+        ::close(fd);
+        return error;
+      }
+      MappedFile file;
+      file.size_ = static_cast<size_t>(st.st_size);
+      if (file.size_ != 0) {
+        auto data = mmap(nullptr, file.size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+          auto error = errno_error();
+          ::close(fd);
+          return error;
+        }
+        file.data_ = static_cast<const uint8_t *>(data);
+        madvise(data, file.size_, MADV_SEQUENTIAL);
+      }
+      ::close(fd);
+      return file;
+    }
+
+    MappedFile(MappedFile &&other) noexcept
+        : data_{std::exchange(other.data_, nullptr)},
+          size_{std::exchange(other.size_, 0)},
+          released_{std::exchange(other.released_, 0)} {}
+
+    MappedFile &operator=(MappedFile &&other) noexcept {
+      if (this != &other) {
+        unmap();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        released_ = std::exchange(other.released_, 0);
+      }
+      return *this;
+    }
+
+    ~MappedFile() {
+      unmap();
+    }
+
+    std::span<const uint8_t> bytes() const {
+      return {data_, size_};
+    }
+
+    /**
+     * Let kernel drop loaded pages before `offset`, to keep memory bounded
+     * while reading sequentially.
+     * Bytes stay valid, they are read from file again on access.
+     */
+    void release(size_t offset) {
+      static const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+      offset = std::min(offset, size_) / page_size * page_size;
+      if (offset <= released_) {
+        return;
+      }
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+      madvise(const_cast<uint8_t *>(data_) + released_,
+              offset - released_,
+              MADV_DONTNEED);
+      released_ = offset;
+    }
+
+   private:
+    MappedFile() = default;
+
+    void unmap() {
+      if (data_ != nullptr) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        munmap(const_cast<uint8_t *>(data_), size_);
+        data_ = nullptr;
+      }
+    }
+
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+    size_t released_ = 0;
+  };
+
+}  // namespace jam
@@ -43,6 +43,9 @@ if (NOT TARGET generate_common_types)
   set(GENERATED_FILES
       ${TARGET_DIR}/common-types.hpp
       ${TARGET_DIR}/common-diff.hpp
+      ${TARGET_DIR}/common-views.hpp
+      ${TARGET_DIR}/common-types-tiny.hpp
+      ${TARGET_DIR}/common-types-full.hpp
   )
 
   add_custom_command(
@@ -73,6 +76,8 @@ function(generate_from_asn1 name)
   set(GENERATED_FILES
       ${TARGET_DIR}/${name}-types.hpp
       ${TARGET_DIR}/${name}-diff.hpp
+      ${TARGET_DIR}/${name}-types-tiny.hpp
+      ${TARGET_DIR}/${name}-types-full.hpp
   )
 
   add_custom_command(
@@ -92,6 +97,7 @@ endfunction()
 
 function(add_test_vector name)
   set(TEST_VECTOR_${name} 1 PARENT_SCOPE)
+  set_property(GLOBAL APPEND PROPERTY TEST_VECTOR_NAMES ${name})
   generate_from_asn1(${name})
 
   set(VECTOR_DIR ${PROJECT_SOURCE_DIR}/test-vectors/${name})
@@ -110,6 +116,7 @@ function(add_test_vector name)
 
   add_library(${TEST_VECTOR}__types INTERFACE ${HPP_FILES})
   target_link_libraries(${TEST_VECTOR}__types INTERFACE
+      PkgConfig::libb2
       scale::scale
       test_vectors_headers
   )
@@ -138,6 +145,20 @@ function(add_test_vector name)
       ${TEST_VECTOR}__types
   )
   add_test(${TEST_VECTOR}__transition_test ${TEST_VECTOR}__transition_test)
+
+  if (BENCHMARKS)
+    add_executable(${TEST_VECTOR}__replay_benchmark
+        ${name}.replay.cpp
+        ${PROJECT_SOURCE_DIR}/test-vectors/benchmark.cpp
+    )
+    target_compile_definitions(${TEST_VECTOR}__replay_benchmark PRIVATE PROJECT_SOURCE_DIR="${PROJECT_SOURCE_DIR}")
+    target_link_libraries(${TEST_VECTOR}__replay_benchmark
+        fmt::fmt
+        GTest::gtest
+        headers
+        ${TEST_VECTOR}__types
+    )
+  endif ()
 endfunction()
 
 
@@ -149,4 +170,31 @@ function(add_test_vector_libraries name)
   set(TEST_VECTOR test_vector__${name})
 
   target_link_libraries(${TEST_VECTOR}__transition_test ${ARGN})
+  if (TARGET ${TEST_VECTOR}__replay_benchmark)
+    target_link_libraries(${TEST_VECTOR}__replay_benchmark ${ARGN})
+  endif ()
+endfunction()
+
+
+function(add_test_vector_benchmark name)
+  if (NOT TEST_VECTOR_${name})
+    message(FATAL_ERROR "Call 'add_test_vector(${name})' first")
+  endif ()
+  if (NOT BENCHMARKS)
+    return()
+  endif ()
+
+  set(TEST_VECTOR test_vector__${name})
+
+  add_executable(${TEST_VECTOR}__benchmark
+      ${name}.bench.cpp
+      ${PROJECT_SOURCE_DIR}/test-vectors/benchmark.cpp
+  )
+  target_compile_definitions(${TEST_VECTOR}__benchmark PRIVATE PROJECT_SOURCE_DIR="${PROJECT_SOURCE_DIR}")
+  target_link_libraries(${TEST_VECTOR}__benchmark
+      fmt::fmt
+      headers
+      ${TEST_VECTOR}__types
+      ${ARGN}
+  )
 endfunction()
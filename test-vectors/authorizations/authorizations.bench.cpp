@@ -0,0 +1,87 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstring>
+
+#include <jam_types/authorizations-types.hpp>
+#include <jam_types/config-full.hpp>
+#include <test-vectors/authorizations/authorizations.hpp>
+#include <test-vectors/benchmark.hpp>
+
+/**
+ * Authorizations transition at the full core count, with every pool full and
+ * every second core using an authorizer from its pool.
+ */
+int main() {
+  using namespace jam::test_vectors;
+  using authorizations::Input;
+  using authorizations::State;
+  using CoreAuthorizer = decltype(Input::auths)::value_type;
+
+  const auto &config = config::full;
+  // Multiple of queue size, so wrapping around continues drawing order
+  const size_t kSlots = 12 * config.auth_queue_size;
+
+  uint32_t counter = 0;
+  auto next_hash = [&] {
+    AuthorizerHash hash{};
+    memcpy(hash.data(), &counter, sizeof(counter));
+    ++counter;
+    return hash;
+  };
+
+  State state;
+  state.auth_pools.resize(config.cores_count);
+  state.auth_queues.resize(config.cores_count);
+  for (CoreIndex core = 0; core < config.cores_count; ++core) {
+    auto &queue = state.auth_queues[core];
+    queue.resize(config.auth_queue_size);
+    for (auto &hash : queue) {
+      hash = next_hash();
+    }
+    // As if drawn at slot 0
+    auto &pool = state.auth_pools[core];
+    while (pool.size() + 1 < config.auth_pool_max_size) {
+      pool.push_back(next_hash());
+    }
+    pool.push_back(queue[0]);
+  }
+
+  // Authorizer drawn at previous slot is used, so it is present in the pool
+  // as long as state is advanced slot by slot
+  std::vector<Input> inputs(kSlots);
+  for (uint32_t slot = 1; slot <= kSlots; ++slot) {
+    auto &input = inputs[slot - 1];
+    input.slot = slot;
+    for (CoreIndex core = 0; core < config.cores_count; core += 2) {
+      const auto index = (slot - 1) % config.auth_queue_size;
+      input.auths.emplace_back(
+          CoreAuthorizer{core, state.auth_queues[core][index]});
+    }
+  }
+
+  fmt::println("cores: {}, pool size: {}, queue size: {}",
+               config.cores_count,
+               config.auth_pool_max_size,
+               config.auth_queue_size);
+
+  size_t i = 0;
+  auto copied_state = state;
+  benchmark("authorizations::transition", 100, 10000, [&] {
+    auto result = jam::authorizations::transition(
+        config, copied_state, inputs[i++ % kSlots]);
+    doNotOptimize(result);
+    copied_state = std::move(result.first);
+  });
+
+  i = 0;
+  auto in_place_state = state;
+  benchmark("authorizations::transition_in_place", 100, 10000, [&] {
+    auto output = jam::authorizations::transition_in_place(
+        config, in_place_state, inputs[i++ % kSlots]);
+    doNotOptimize(output);
+  });
+}
@@ -6,8 +6,10 @@
 
 #pragma once
 
-#include <list>
+#include <cassert>
+#include <memory_resource>
 #include <set>
+#include <vector>
 
 namespace jam::authorizations {
   namespace types = jam::test_vectors;
@@ -20,16 +22,19 @@ namespace jam::authorizations {
     return std::vector(r.begin(), r.end());
   }
 
-  /// Given state and input, derive next state and output.
-  inline std::pair<types::authorizations::State, types::authorizations::Output>
-  transition(const types::Config &config,
-             const types::authorizations::State &state,
-             const types::authorizations::Input &input) {
+  /// Given input, derive next state in place and return output.
+  /// Temporary containers are allocated from `arena`.
+  inline types::authorizations::Output transition_in_place(
+      const types::Config &config,
+      types::authorizations::State &state,
+      const types::authorizations::Input &input,
+      std::pmr::memory_resource *arena = std::pmr::get_default_resource()) {
     // (137)
 
     // [GP 0.4.5 8 85]
-    // [α[c]] - set of authorizers allowable for a particular core
-    const auto &pool = state.auth_pools;
+    // [α[c]] - set of authorizers allowable for a particular core.
+    // Mutated to α'[c] in place.
+    auto &pools = state.auth_pools;
 
     // [GP 0.4.5 8 85]
     // [φ[c]] - the core’s current authorizer queue, from which we draw values
@@ -41,21 +46,16 @@ namespace jam::authorizations {
     // Since α′ is dependent on φ′, practically speaking, this step must be
     // computed after accumulation, the stage in which φ′ is defined.
 
-    // [α'[c]]
-    auto pools = [&] {
-      std::vector<std::list<types::AuthorizerHash>> pools{config.cores_count};
-      for (types::CoreIndex core = 0; core < config.cores_count; ++core) {
-        const auto &pool = state.auth_pools[core];
-        assert(pool.size() <= config.auth_pool_max_size);
-        pools[core] = {pool.begin(), pool.end()};
-      }
-      return pools;
-    }();
+    assert(pools.size() == config.cores_count);
+    assert(config.auth_pool_max_size
+           <= std::remove_cvref_t<decltype(pools[0])>::capacity());
+
+    const auto index = input.slot % config.auth_queue_size;
 
     // The state transition of a block involves placing a new authorization into
     // the pool from the queue
 
-    std::vector deleted(config.cores_count, false);
+    std::pmr::vector<bool> deleted(config.cores_count, false, arena);
 
     // remove authorizer of input
     for (auto &[core, authorizer] : input.auths) {
@@ -64,46 +64,40 @@ namespace jam::authorizations {
       if (erase(pool, authorizer) != 0) {
         deleted[core] = true;
 
-        assert(state.auth_queues[core].size() == config.auth_queue_size);
-        const auto index = input.slot % config.auth_queue_size;
-        const auto &queueing = state.auth_queues[core][index];
-        pool.emplace_back(queueing);
+        assert(queues[core].size() == config.auth_queue_size);
+        pool.push_back(queues[core][index]);
       }
     }
 
-    // Note that we utilize the guarantees extrinsic EG to remove the oldest
-    // authorizer which has been used to justify a guaranteed work-package in
-    // the current block.
     for (types::CoreIndex core = 0; core < config.cores_count; ++core) {
-      if (not deleted[core]) {
-        auto &pool = pools[core];
-        if (pool.size() == config.auth_pool_max_size) {
-          pool.pop_front();
-        }
+      auto &pool = pools[core];
+
+      // Note that we utilize the guarantees extrinsic EG to remove the oldest
+      // authorizer which has been used to justify a guaranteed work-package in
+      // the current block.
+      if (not deleted[core] and pool.size() == config.auth_pool_max_size) {
+        pool.pop_front();
       }
-    }
 
-    // draw authorizers to fill the pool
-    for (types::CoreIndex core = 0; core < config.cores_count; ++core) {
-      auto &pool = pools[core];
+      // draw authorizers to fill the pool
       if (pool.size() < config.auth_pool_max_size) {
-        assert(state.auth_queues[core].size() == config.auth_queue_size);
-        const auto index = input.slot % config.auth_queue_size;
-        const auto &queueing = state.auth_queues[core][index];
-        pool.emplace_back(queueing);
+        assert(queues[core].size() == config.auth_queue_size);
+        pool.push_back(queues[core][index]);
       }
     }
 
-    types::authorizations::State new_state;
-
-    new_state.auth_pools.resize(config.cores_count);
-    for (types::CoreIndex core = 0; core < config.cores_count; ++core) {
-      auto &pool = pools[core];
-      new_state.auth_pools[core] = {pool.begin(), pool.end()};
-    }
-
-    new_state.auth_queues = queues;
+    return qtils::Empty{};
+  }
 
-    return {new_state, qtils::Empty{}};
+  /// Given state and input, derive next state and output.
+  inline std::pair<types::authorizations::State, types::authorizations::Output>
+  transition(const types::Config &config,
+             const types::authorizations::State &state,
+             const types::authorizations::Input &input,
+             std::pmr::memory_resource *arena =
+                 std::pmr::get_default_resource()) {
+    auto new_state = state;
+    auto output = transition_in_place(config, new_state, input, arena);
+    return {std::move(new_state), std::move(output)};
   }
 }  // namespace jam::authorizations
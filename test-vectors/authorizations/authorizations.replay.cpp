@@ -0,0 +1,12 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <jam_types/authorizations-types.hpp>
+#include <test-vectors/authorizations/authorizations.hpp>
+#include <test-vectors/authorizations/vectors.hpp>
+#include <test-vectors/replay.hpp>
+
+BENCHMARK_VECTORS_REPLAY(authorizations)
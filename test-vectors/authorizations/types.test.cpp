@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <jam_types/authorizations-types-full.hpp>
+#include <jam_types/authorizations-types-tiny.hpp>
 #include <test-vectors/authorizations/vectors.hpp>
 
 GTEST_VECTORS(Authorizations, authorizations);
@@ -12,3 +14,8 @@ GTEST_VECTORS(Authorizations, authorizations);
  * Check python generated scale encoding/decoding against test vectors.
  */
 GTEST_VECTORS_TEST_REENCODE(Authorizations, authorizations);
+
+/**
+ * Check types specialized for constant sets against test vectors.
+ */
+GTEST_VECTORS_TEST_REENCODE_SPECIALIZED(Authorizations, authorizations);
@@ -0,0 +1,77 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#if __has_include(<malloc/malloc.h>)
+#include <malloc/malloc.h>
+#define JAM_MALLOC_SIZE malloc_size
+#else
+#include <malloc.h>
+#define JAM_MALLOC_SIZE malloc_usable_size
+#endif
+
+#include <test-vectors/benchmark.hpp>
+
+namespace {
+  /// Count block returned by allocator, throw if allocation failed
+  void *allocated(void *ptr) {
+    if (ptr == nullptr) {
+      throw std::bad_alloc{};
+    }
+    jam::test_vectors::allocation_count.fetch_add(1,
+                                                  std::memory_order_relaxed);
+    jam::test_vectors::allocated_bytes.fetch_add(JAM_MALLOC_SIZE(ptr),
+                                                 std::memory_order_relaxed);
+    return ptr;
+  }
+
+  /// Uncount and free block
+  void deallocate(void *ptr) {
+    if (ptr != nullptr) {
+      jam::test_vectors::allocated_bytes.fetch_sub(JAM_MALLOC_SIZE(ptr),
+                                                   std::memory_order_relaxed);
+    }
+    std::free(ptr);
+  }
+}  // namespace
+
+/**
+ * Global allocation functions, replaced to count allocations of benchmarks
+ * and bytes held by them.
+ * Array and nothrow forms, both plain and aligned, call these ones by
+ * default.
+ */
+
+void *operator new(std::size_t size) {
+  return allocated(std::malloc(size == 0 ? 1 : size));
+}
+
+void operator delete(void *ptr) noexcept {
+  deallocate(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+  deallocate(ptr);
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+  const auto alignment = static_cast<std::size_t>(align);
+  // `aligned_alloc` requires size to be multiple of alignment
+  const auto rounded =
+      (std::max<std::size_t>(size, 1) + alignment - 1) / alignment * alignment;
+  return allocated(std::aligned_alloc(alignment, rounded));
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept {
+  deallocate(ptr);
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept {
+  deallocate(ptr);
+}
@@ -0,0 +1,82 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string_view>
+
+#include <fmt/format.h>
+
+/**
+ * Common functions for benchmarks
+ */
+
+namespace jam::test_vectors {
+  /**
+   * Number of calls to global `operator new`.
+   * Counted only if benchmark is linked with `benchmark.cpp`, which replaces
+   * it.
+   */
+  inline std::atomic_size_t allocation_count = 0;
+
+  /**
+   * Bytes of heap blocks currently allocated by global `operator new`,
+   * including allocator rounding, e.g. to measure memory held by container.
+   * Counted only if benchmark is linked with `benchmark.cpp`.
+   */
+  inline std::atomic_ptrdiff_t allocated_bytes = 0;
+
+  /**
+   * Mean cost of one run of benchmark.
+   */
+  struct BenchmarkResult {
+    std::chrono::nanoseconds time;
+    double allocations;
+  };
+
+  /**
+   * Prevent compiler from optimizing out computation of `value`.
+   */
+  template <typename T>
+  void doNotOptimize(const T &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+  }
+
+  /**
+   * Run `f` `warmup` times, then measure `iterations` runs of it.
+   * Prints and returns mean time and number of allocations per run.
+   */
+  inline BenchmarkResult benchmark(std::string_view name,
+                                   size_t warmup,
+                                   size_t iterations,
+                                   auto &&f) {
+    using Clock = std::chrono::steady_clock;
+    for (size_t i = 0; i < warmup; ++i) {
+      f();
+    }
+    auto allocations_begin = allocation_count.load(std::memory_order_relaxed);
+    auto begin = Clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+      f();
+    }
+    auto total = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now() - begin);
+    auto allocations =
+        allocation_count.load(std::memory_order_relaxed) - allocations_begin;
+    BenchmarkResult result{
+        .time = total / iterations,
+        .allocations = static_cast<double>(allocations) / iterations,
+    };
+    fmt::println("{:<48} {:>12} ns/op {:>10.1f} allocs/op",
+                 name,
+                 result.time.count(),
+                 result.allocations);
+    return result;
+  }
+}  // namespace jam::test_vectors
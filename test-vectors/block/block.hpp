@@ -0,0 +1,164 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <tuple>
+
+#include <jam_types/authorizations-types.hpp>
+#include <jam_types/disputes-types.hpp>
+#include <jam_types/history-types.hpp>
+#include <jam_types/safrole-types.hpp>
+#include <se/impl/dispatcher.hpp>
+#include <test-vectors/authorizations/authorizations.hpp>
+#include <test-vectors/disputes/disputes.hpp>
+#include <test-vectors/history/history.hpp>
+#include <test-vectors/safrole/safrole.hpp>
+#include <test-vectors/stage-graph.hpp>
+
+namespace jam::block {
+  namespace types = jam::test_vectors;
+
+  /**
+   * States of sub-transitions of block.
+   * Test-vector states are projections of the whole state. Components shared
+   * by disputes and safrole (τ, κ and λ) are owned by `safrole`, copies in
+   * `disputes` are only a view refreshed by `project_shared`.
+   */
+  struct State {
+    types::disputes::State disputes;
+    types::safrole::State safrole;
+    types::history::State history;
+    types::authorizations::State authorizations;
+  };
+
+  /**
+   * Inputs of sub-transitions, derived from block.
+   */
+  struct Input {
+    types::disputes::Input disputes;
+    types::safrole::Input safrole;
+    types::history::Input history;
+    types::authorizations::Input authorizations;
+  };
+
+  /**
+   * Outputs of sub-transitions, each one is set if its stage was run.
+   */
+  struct Output {
+    std::optional<types::disputes::Output> disputes;
+    std::optional<types::safrole::Output> safrole;
+    std::optional<types::history::Output> history;
+    std::optional<types::authorizations::Output> authorizations;
+  };
+
+  /**
+   * Copy components owned by safrole state into disputes state, which reads
+   * them but does not change them.
+   */
+  inline void project_shared(State &state) {
+    state.disputes.tau = state.safrole.tau;
+    state.disputes.kappa = state.safrole.kappa;
+    state.disputes.lambda = state.safrole.lambda;
+  }
+
+  /**
+   * Arena for temporary containers of one sub-transition.
+   * Stages may run concurrently and `monotonic_buffer_resource` is not
+   * thread-safe, so each stage owns its arena. It lives on stage's stack and
+   * is dropped at once when stage is finished, so it is reset per block;
+   * temporaries exceeding buffer are allocated from default resource.
+   */
+  class StageArena {
+   public:
+    static constexpr size_t kBufferSize = 64 << 10;
+
+    StageArena() = default;
+    StageArena(const StageArena &) = delete;
+    StageArena &operator=(const StageArena &) = delete;
+
+    std::pmr::memory_resource *resource() {
+      return &resource_;
+    }
+
+   private:
+    alignas(std::max_align_t) std::array<std::byte, kBufferSize> buffer_;
+    std::pmr::monotonic_buffer_resource resource_{buffer_.data(),
+                                                  buffer_.size()};
+  };
+
+  /**
+   * Given state and input, derive next state in place and return output with
+   * per-stage time breakdown.
+   * Data dependencies between sub-transitions:
+   * - safrole reads posterior offenders ψ'_o produced by disputes;
+   * - history and authorizations are independent of others.
+   * Independent sub-transitions are run concurrently on dispatcher pool, or
+   * one by one if dispatcher is not provided.
+   */
+  inline std::pair<Output, StageReport> transition_in_place(
+      const types::Config &config,
+      se::Dispatcher *dispatcher,
+      State &state,
+      const Input &input) {
+    project_shared(state);
+    Output output;
+    StageGraph graph;
+    auto disputes_stage = graph.add("disputes", {}, [&] {
+      StageArena arena;
+      auto [state_tick, out] = disputes::transition(
+          config, state.disputes, input.disputes, arena.resource());
+      state.disputes = std::move(state_tick);
+      output.disputes = std::move(out);
+    });
+    graph.add("safrole", {disputes_stage}, [&] {
+      // [GP 0.4.5 6.3 59]
+      // https://github.com/gavofyork/graypaper/blob/v0.4.5/text/safrole.tex#L101
+      // ψ'_o excludes offenders from the next validator keys
+      const auto &offenders = state.disputes.psi.offenders;
+      state.safrole.post_offenders = {offenders.begin(), offenders.end()};
+      StageArena arena;
+      auto [state_tick, out] = safrole::transition(
+          config, state.safrole, input.safrole, arena.resource());
+      state.safrole = std::move(state_tick);
+      output.safrole = std::move(out);
+    });
+    graph.add("history", {}, [&] {
+      output.history =
+          history::transition_in_place(config, state.history, input.history);
+    });
+    graph.add("authorizations", {}, [&] {
+      StageArena arena;
+      output.authorizations =
+          authorizations::transition_in_place(config,
+                                              state.authorizations,
+                                              input.authorizations,
+                                              arena.resource());
+    });
+    auto report = graph.run(dispatcher);
+    project_shared(state);
+    return {std::move(output), std::move(report)};
+  }
+
+  /**
+   * Given state and input, derive next state and output with per-stage time
+   * breakdown.
+   */
+  inline std::tuple<State, Output, StageReport> transition(
+      const types::Config &config,
+      se::Dispatcher *dispatcher,
+      const State &state,
+      const Input &input) {
+    auto state_tick = state;
+    auto [output, report] =
+        transition_in_place(config, dispatcher, state_tick, input);
+    return {std::move(state_tick), std::move(output), std::move(report)};
+  }
+}  // namespace jam::block
@@ -0,0 +1,104 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <jam_types/config-tiny.hpp>
+#include <se/impl/async_dispatcher_impl.hpp>
+#include <test-vectors/block/block.hpp>
+
+namespace types = jam::test_vectors;
+
+class BlockTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    auto &authorizations = state.authorizations;
+    authorizations.auth_pools.resize(config.cores_count);
+    authorizations.auth_queues.resize(config.cores_count);
+    for (auto &queue : authorizations.auth_queues) {
+      queue.resize(config.auth_queue_size);
+    }
+    input.safrole.slot = 1;
+    input.authorizations.slot = 1;
+    input.history.header_hash[0] = 1;
+  }
+
+  void TearDown() override {
+    dispatcher.dispose();
+  }
+
+  const types::Config &config = types::config::tiny;
+  jam::se::AsyncDispatcher<1, 4> dispatcher;
+  jam::block::State state;
+  jam::block::Input input;
+};
+
+/**
+ * @given state and input of block without extrinsics
+ * @when run block transition on dispatcher pool and one by one
+ * @then every stage is run, and both runs give the same state and output
+ */
+TEST_F(BlockTest, ConcurrentRunMatchesSequential) {
+  auto [seq_state, seq_output, seq_report] =
+      jam::block::transition(config, nullptr, state, input);
+  auto [state_tick, output, report] =
+      jam::block::transition(config, &dispatcher, state, input);
+
+  ASSERT_TRUE(output.disputes.has_value());
+  ASSERT_TRUE(output.safrole.has_value());
+  ASSERT_TRUE(output.history.has_value());
+  ASSERT_TRUE(output.authorizations.has_value());
+  EXPECT_TRUE(*output.disputes == *seq_output.disputes);
+  EXPECT_TRUE(*output.safrole == *seq_output.safrole);
+
+  EXPECT_EQ(state_tick.safrole.tau, 1);
+  EXPECT_EQ(state_tick.history.beta.size(), 1);
+  EXPECT_TRUE(state_tick.disputes == seq_state.disputes);
+  EXPECT_TRUE(state_tick.safrole == seq_state.safrole);
+  EXPECT_TRUE(state_tick.history == seq_state.history);
+  EXPECT_TRUE(state_tick.authorizations == seq_state.authorizations);
+
+  ASSERT_EQ(report.stages.size(), 4);
+  EXPECT_EQ(report.stages[0].name, "disputes");
+  EXPECT_EQ(report.stages[1].name, "safrole");
+  EXPECT_GE(report.stages[1].begin,
+            report.stages[0].begin + report.stages[0].duration);
+}
+
+/**
+ * @given state with offender judged by previous blocks
+ * @when run block transition
+ * @then safrole reads posterior offenders produced by disputes stage
+ */
+TEST_F(BlockTest, OffendersReachSafrole) {
+  types::Ed25519Public offender{};
+  offender[0] = 1;
+  state.disputes.psi.offenders.emplace_back(offender);
+
+  auto [state_tick, output, report] =
+      jam::block::transition(config, &dispatcher, state, input);
+
+  ASSERT_EQ(state_tick.disputes.psi.offenders.size(), 1);
+  ASSERT_EQ(state_tick.safrole.post_offenders.size(), 1);
+  EXPECT_TRUE(state_tick.safrole.post_offenders[0] == offender);
+}
+
+/**
+ * @given state whose disputes view of τ disagrees with safrole
+ * @when run block transition
+ * @then disputes view of τ, κ and λ follows posterior safrole state
+ */
+TEST_F(BlockTest, SharedComponentsOwnedBySafrole) {
+  state.disputes.tau = 7;
+
+  auto [state_tick, output, report] =
+      jam::block::transition(config, &dispatcher, state, input);
+
+  EXPECT_EQ(state_tick.safrole.tau, 1);
+  EXPECT_EQ(state_tick.disputes.tau, state_tick.safrole.tau);
+  EXPECT_TRUE(state_tick.disputes.kappa == state_tick.safrole.kappa);
+  EXPECT_TRUE(state_tick.disputes.lambda == state_tick.safrole.lambda);
+}
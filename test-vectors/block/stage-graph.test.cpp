@@ -0,0 +1,99 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <se/impl/async_dispatcher_impl.hpp>
+#include <test-vectors/stage-graph.hpp>
+
+using jam::StageGraph;
+
+class StageGraphTest : public testing::Test {
+ protected:
+  void TearDown() override {
+    dispatcher.dispose();
+  }
+
+  jam::se::AsyncDispatcher<1, 4> dispatcher;
+};
+
+/**
+ * @given graph of stages where "c" depends on "a" and "b"
+ * @when run with and without dispatcher
+ * @then every stage is run once, after stages it depends on
+ */
+TEST_F(StageGraphTest, RespectsDependencies) {
+  using jam::se::Dispatcher;
+  for (auto *d : {static_cast<Dispatcher *>(nullptr),
+                  static_cast<Dispatcher *>(&dispatcher)}) {
+    std::mutex mutex;
+    std::vector<std::string> order;
+    auto push = [&](std::string name) {
+      return [&, name] {
+        std::lock_guard lock{mutex};
+        order.emplace_back(name);
+      };
+    };
+    StageGraph graph;
+    auto a = graph.add("a", {}, push("a"));
+    auto b = graph.add("b", {}, push("b"));
+    graph.add("c", {a, b}, push("c"));
+    graph.add("d", {}, push("d"));
+    auto report = graph.run(d);
+
+    ASSERT_EQ(order.size(), 4);
+    EXPECT_EQ(std::ranges::count(order, "c"), 1);
+    auto c = std::ranges::find(order, "c");
+    EXPECT_NE(std::find(order.begin(), c, "a"), c);
+    EXPECT_NE(std::find(order.begin(), c, "b"), c);
+    ASSERT_EQ(report.stages.size(), 4);
+    EXPECT_EQ(report.stages[2].name, "c");
+    EXPECT_GE(report.stages[2].begin,
+              report.stages[0].begin + report.stages[0].duration);
+  }
+}
+
+/**
+ * @given graph where first stage throws
+ * @when run
+ * @then exception is rethrown and dependent stage is skipped
+ */
+TEST_F(StageGraphTest, RethrowsStageException) {
+  bool dependent_run = false;
+  StageGraph graph;
+  auto a = graph.add("a", {}, [] { throw std::runtime_error{"a"}; });
+  graph.add("b", {a}, [&] { dependent_run = true; });
+  EXPECT_THROW(graph.run(&dispatcher), std::runtime_error);
+  EXPECT_FALSE(dependent_run);
+}
+
+/**
+ * @given many short-lived graphs of independent stages with dependent ones
+ * @when each graph is run on pool and dropped right after run
+ * @then every stage is run, and pool threads finishing their stages do not
+ * touch dropped graphs (checked under sanitizers)
+ */
+TEST_F(StageGraphTest, GraphMayBeDroppedAfterRun) {
+  std::atomic_size_t runs = 0;
+  for (size_t i = 0; i < 1000; ++i) {
+    auto graph = std::make_unique<StageGraph>();
+    auto a = graph->add("a", {}, [&] { ++runs; });
+    auto b = graph->add("b", {}, [&] { ++runs; });
+    graph->add("c", {a, b}, [&] { ++runs; });
+    graph->add("d", {}, [&] { ++runs; });
+    graph->run(&dispatcher);
+    graph.reset();
+  }
+  EXPECT_EQ(runs.load(), 4000);
+}
@@ -0,0 +1,154 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+
+#include <qtils/byte_arr.hpp>
+#include <qtils/outcome.hpp>
+
+#include <storage/buffer_map_types.hpp>
+#include <test-vectors/block/block.hpp>
+#include <test-vectors/tracked.hpp>
+
+namespace jam::block {
+  /**
+   * Safrole component γ ≡ (γ_k, γ_z, γ_s, γ_a), stored under one key.
+   */
+  struct Gamma {
+    decltype(types::safrole::State::gamma_k) gamma_k;
+    decltype(types::safrole::State::gamma_z) gamma_z;
+    decltype(types::safrole::State::gamma_s) gamma_s;
+    decltype(types::safrole::State::gamma_a) gamma_a;
+    bool operator==(const Gamma &) const = default;
+  };
+
+  /**
+   * State components by index of state-key mapping C(i), each tracked for
+   * modification. After block only modified components are re-encoded and
+   * written to storage, encodings and hashes of others are kept from
+   * previous blocks.
+   */
+  class StateComponents {
+   public:
+    using Key = qtils::ByteArr<32>;
+
+    // [GP 0.4.5 D.1]
+    // https://github.com/gavofyork/graypaper/blob/v0.4.5/text/merklization.tex#L14
+    /// Key of component C(i)
+    static Key key(uint8_t index) {
+      Key key{};
+      key[0] = index;
+      return key;
+    }
+
+    /**
+     * Take components from states of sub-transitions. Component is marked
+     * modified and copied only if it differs from previous one. Comparison
+     * is cheaper than re-encoding, and for interned validator sets is
+     * comparison of pointers or hashes.
+     * Sub-states are projections sharing components; τ, κ and λ are taken
+     * from safrole, which owns them.
+     */
+    void update(const State &state) {
+      alpha_.set(state.authorizations.auth_pools);
+      phi_.set(state.authorizations.auth_queues);
+      beta_.set(state.history.beta);
+      gamma_.modify([&](Gamma &gamma) {
+        using G = Tracked<Gamma>;
+        // Not short-circuited, every changed field is copied
+        return G::assign(gamma.gamma_k, state.safrole.gamma_k)
+             | G::assign(gamma.gamma_z, state.safrole.gamma_z)
+             | G::assign(gamma.gamma_s, state.safrole.gamma_s)
+             | G::assign(gamma.gamma_a, state.safrole.gamma_a);
+      });
+      psi_.set(state.disputes.psi);
+      eta_.set(state.safrole.eta);
+      iota_.set(state.safrole.iota);
+      kappa_.set(state.safrole.kappa);
+      lambda_.set(state.safrole.lambda);
+      rho_.set(state.disputes.rho);
+      tau_.set(state.safrole.tau);
+    }
+
+    /**
+     * Re-encode modified components and write them to storage in one batch.
+     * Returns number of written components. On failure components stay
+     * modified, to be written by next call.
+     */
+    outcome::result<size_t> persist(const types::Config &config,
+                                    storage::BufferStorage &storage) {
+      auto batch = storage.batch();
+      std::bitset<kMaxIndex + 1> flushed;
+      outcome::result<void> result = outcome::success();
+      forEachMutable([&](uint8_t index, auto &component) {
+        if (result and component.flush(config)) {
+          flushed.set(index);
+          result = batch->put(storage::ByteView{key(index)},
+                              storage::ByteView{component.encoded()});
+        }
+      });
+      if (result) {
+        result = batch->commit();
+      }
+      if (not result) {
+        forEachMutable([&](uint8_t index, auto &component) {
+          if (flushed.test(index)) {
+            component.mutate();
+          }
+        });
+        return result.error();
+      }
+      return flushed.count();
+    }
+
+    /// Call `f(index, component)` for each component, e.g. to collect
+    /// hashes of encodings
+    template <typename F>
+    void forEach(F &&f) const {
+      visit(*this, f);
+    }
+
+   private:
+    /// Largest index i of component C(i), `flushed` is indexed by i
+    static constexpr uint8_t kMaxIndex = 11;
+
+    template <typename F>
+    void forEachMutable(F &&f) {
+      visit(*this, f);
+    }
+
+    static void visit(auto &self, auto &f) {
+      // [GP 0.4.5 D.2]
+      // https://github.com/gavofyork/graypaper/blob/v0.4.5/text/merklization.tex#L26
+      f(uint8_t{1}, self.alpha_);
+      f(uint8_t{2}, self.phi_);
+      f(uint8_t{3}, self.beta_);
+      f(uint8_t{4}, self.gamma_);
+      f(uint8_t{5}, self.psi_);
+      f(uint8_t{6}, self.eta_);
+      f(uint8_t{7}, self.iota_);
+      f(uint8_t{8}, self.kappa_);
+      f(uint8_t{9}, self.lambda_);
+      f(uint8_t{10}, self.rho_);
+      f(uint8_t{11}, self.tau_);
+    }
+
+    Tracked<decltype(types::authorizations::State::auth_pools)> alpha_;
+    Tracked<decltype(types::authorizations::State::auth_queues)> phi_;
+    Tracked<decltype(types::history::State::beta)> beta_;
+    Tracked<Gamma> gamma_;
+    Tracked<decltype(types::disputes::State::psi)> psi_;
+    Tracked<decltype(types::safrole::State::eta)> eta_;
+    Tracked<decltype(types::safrole::State::iota)> iota_;
+    Tracked<decltype(types::safrole::State::kappa)> kappa_;
+    Tracked<decltype(types::safrole::State::lambda)> lambda_;
+    Tracked<decltype(types::disputes::State::rho)> rho_;
+    Tracked<decltype(types::safrole::State::tau)> tau_;
+  };
+}  // namespace jam::block
@@ -0,0 +1,149 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <jam_types/config-tiny.hpp>
+#include <storage/in_memory/in_memory_storage.hpp>
+#include <test-vectors/block/state-components.hpp>
+
+namespace types = jam::test_vectors;
+using jam::Tracked;
+using jam::block::StateComponents;
+using jam::storage::ByteView;
+using jam::storage::InMemoryStorage;
+
+class StateComponentsTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    auto &authorizations = state.authorizations;
+    authorizations.auth_pools.resize(config.cores_count);
+    authorizations.auth_queues.resize(config.cores_count);
+    for (auto &queue : authorizations.auth_queues) {
+      queue.resize(config.auth_queue_size);
+    }
+  }
+
+  /// Indices of components whose encoding in `storage` differs from their
+  /// current value, or which are missing
+  std::vector<uint8_t> stale() const {
+    std::vector<uint8_t> indices;
+    components.forEach([&](uint8_t index, const auto &component) {
+      using T = std::decay_t<decltype(component.value())>;
+      auto key = StateComponents::key(index);
+      auto encoded = storage.tryGet(ByteView{key}).value();
+      if (not encoded) {
+        indices.emplace_back(index);
+        return;
+      }
+      auto decoded =
+          jam::decode_with_config<T>(encoded->view(), config).value();
+      if (not(decoded == component.value())) {
+        indices.emplace_back(index);
+      }
+    });
+    return indices;
+  }
+
+  const types::Config &config = types::config::tiny;
+  jam::block::State state;
+  StateComponents components;
+  InMemoryStorage storage;
+};
+
+/**
+ * @given tracked value
+ * @when it is set to equal and different values, and flushed
+ * @then it is marked modified only by different value, and flush re-encodes
+ * only modified value
+ */
+TEST(TrackedTest, DirtyTracking) {
+  const types::Config &config = types::config::tiny;
+  Tracked<uint32_t> value{1};
+  EXPECT_TRUE(value.dirty());
+  EXPECT_TRUE(value.flush(config));
+  EXPECT_FALSE(value.dirty());
+  auto hash = value.hash();
+  EXPECT_EQ(hash, jam::crypto::Blake::hash(value.encoded()));
+
+  EXPECT_FALSE(value.set(1));
+  EXPECT_FALSE(value.dirty());
+  EXPECT_FALSE(value.flush(config));
+
+  EXPECT_TRUE(value.set(2));
+  EXPECT_TRUE(value.dirty());
+  EXPECT_EQ(*value, 2);
+  EXPECT_TRUE(value.flush(config));
+  EXPECT_NE(value.hash(), hash);
+  EXPECT_EQ(value.encoded(), jam::encode_with_config(2u, config).value());
+
+  value.mutate() = 2;
+  EXPECT_TRUE(value.dirty());
+}
+
+/**
+ * @given component indices
+ * @when keys are built
+ * @then key of C(i) is i followed by zero bytes
+ */
+TEST(StateComponentsKeyTest, KeyLayout) {
+  for (uint8_t index : {1, 4, 11}) {
+    auto key = StateComponents::key(index);
+    EXPECT_EQ(key[0], index);
+    for (size_t i = 1; i < key.size(); ++i) {
+      EXPECT_EQ(key[i], 0);
+    }
+  }
+}
+
+/**
+ * @given state components taken from state
+ * @when they are persisted to storage
+ * @then every component C(1)..C(11) is written, and decodes to its value
+ */
+TEST_F(StateComponentsTest, PersistRoundTrip) {
+  components.update(state);
+  auto written = components.persist(config, storage);
+  ASSERT_TRUE(written.has_value());
+  EXPECT_EQ(written.value(), 11);
+  EXPECT_TRUE(stale().empty());
+
+  components.forEach([&](uint8_t index, const auto &component) {
+    EXPECT_FALSE(component.dirty());
+    auto encoded =
+        storage.tryGet(ByteView{StateComponents::key(index)}).value();
+    ASSERT_TRUE(encoded.has_value());
+    EXPECT_EQ(component.hash(), jam::crypto::Blake::hash(encoded->view()));
+  });
+}
+
+/**
+ * @given persisted state components
+ * @when one component of state is changed and components are persisted again
+ * @then only that component is rewritten
+ */
+TEST_F(StateComponentsTest, PersistOnlyModified) {
+  components.update(state);
+  ASSERT_TRUE(components.persist(config, storage).has_value());
+
+  components.update(state);
+  auto unchanged = components.persist(config, storage);
+  ASSERT_TRUE(unchanged.has_value());
+  EXPECT_EQ(unchanged.value(), 0);
+
+  state.safrole.tau = 7;
+  state.safrole.gamma_z[0] = 1;
+  components.update(state);
+  components.forEach([&](uint8_t index, const auto &component) {
+    EXPECT_EQ(component.dirty(), index == 4 or index == 11) << int{index};
+  });
+  EXPECT_EQ(stale(), (std::vector<uint8_t>{4, 11}));
+
+  auto written = components.persist(config, storage);
+  ASSERT_TRUE(written.has_value());
+  EXPECT_EQ(written.value(), 2);
+  EXPECT_TRUE(stale().empty());
+}
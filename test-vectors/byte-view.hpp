@@ -0,0 +1,161 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <limits>
+#include <span>
+#include <system_error>
+
+#include <qtils/byte_arr.hpp>
+
+#include <jam_types/config.hpp>
+#include <scale/jam_scale.hpp>
+
+/**
+ * Borrowed counterparts of fixed-size byte fields, used by generated view
+ * types. They are decoded only by `jam::decode_borrowed` and point into its
+ * input, which must outlive them.
+ */
+
+namespace jam {
+  namespace detail {
+    /**
+     * Take `n` bytes from decoder without copying.
+     * Scale passes nested fields as `scale::Decoder &`, so decoder is cast
+     * statically instead of being checked per field; view types are decoded
+     * only by `BorrowingDecoder` (checked in debug builds).
+     */
+    inline std::span<const uint8_t> borrow(scale::Decoder &decoder, size_t n) {
+      assert(dynamic_cast<BorrowingDecoder *>(&decoder) != nullptr);
+      return static_cast<BorrowingDecoder &>(decoder).borrow(n);
+    }
+  }  // namespace detail
+
+  /**
+   * View of `qtils::ByteArr<N>`.
+   */
+  template <size_t N>
+  class ByteArrView {
+   public:
+    ByteArrView() = default;
+    explicit ByteArrView(std::span<const uint8_t, N> bytes) : bytes_{bytes} {}
+
+    static constexpr size_t size() {
+      return N;
+    }
+
+    const uint8_t *data() const {
+      return bytes_.data();
+    }
+
+    auto begin() const {
+      return bytes_.begin();
+    }
+
+    auto end() const {
+      return bytes_.end();
+    }
+
+    uint8_t operator[](size_t i) const {
+      return bytes_[i];
+    }
+
+    std::span<const uint8_t, N> view() const {
+      return bytes_;
+    }
+
+    operator std::span<const uint8_t>() const {
+      return bytes_;
+    }
+
+    /// Owning copy
+    qtils::ByteArr<N> toArr() const {
+      qtils::ByteArr<N> arr;
+      std::ranges::copy(bytes_, arr.begin());
+      return arr;
+    }
+
+    bool operator==(const ByteArrView &other) const {
+      return std::ranges::equal(bytes_, other.bytes_);
+    }
+
+    friend void encode(const ByteArrView &v, scale::Encoder &encoder) {
+      encoder.write(v.bytes_);
+    }
+
+    friend void decode(ByteArrView &v, scale::Decoder &decoder) {
+      v.bytes_ = std::span<const uint8_t, N>{detail::borrow(decoder, N)};
+    }
+
+   private:
+    static constexpr std::array<uint8_t, N> kZero{};
+
+    std::span<const uint8_t, N> bytes_{kZero};
+  };
+
+  /**
+   * View of `ConfigVec<uint8_t, ConfigField>`, i.e. bytes of size given by
+   * config.
+   */
+  template <typename ConfigField>
+  class ConfigByteView {
+   public:
+    ConfigByteView() = default;
+
+    size_t size() const {
+      return bytes_.size();
+    }
+
+    const uint8_t *data() const {
+      return bytes_.data();
+    }
+
+    auto begin() const {
+      return bytes_.begin();
+    }
+
+    auto end() const {
+      return bytes_.end();
+    }
+
+    uint8_t operator[](size_t i) const {
+      return bytes_[i];
+    }
+
+    operator std::span<const uint8_t>() const {
+      return bytes_;
+    }
+
+    bool operator==(const ConfigByteView &other) const {
+      return std::ranges::equal(bytes_, other.bytes_);
+    }
+
+    friend void encode(const ConfigByteView &v, scale::Encoder &encoder) {
+      [[maybe_unused]] const auto &config =
+          encoder.template getConfig<test_vectors::Config>();
+      assert(v.size() == config.get(ConfigField{}));
+      encoder.write(v.bytes_);
+    }
+
+    friend void decode(ConfigByteView &v, scale::Decoder &decoder) {
+      const auto &config = decoder.template getConfig<test_vectors::Config>();
+      auto n = config.get(ConfigField{});
+      // Unbounded size is length-prefixed, such fields are not borrowed
+      if (n == std::numeric_limits<decltype(n)>::max()) {
+        throw std::system_error{
+            std::make_error_code(std::errc::operation_not_supported)};
+      }
+      v.bytes_ = detail::borrow(decoder, n);
+    }
+
+   private:
+    std::span<const uint8_t> bytes_;
+  };
+}  // namespace jam
@@ -0,0 +1,133 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <charconv>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <regex>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <qtils/read_file.hpp>
+
+#include <jam_types/config-full.hpp>
+#include <jam_types/config-tiny.hpp>
+#include <scale/jam_scale.hpp>
+#include <test-vectors/benchmark.hpp>
+#include <test-vectors/vectors.hpp>
+
+/**
+ * Round-trip benchmark of types, used by benchmark generated from ASN.1
+ * schema by `scripts/asn1.py`.
+ */
+
+namespace jam::test_vectors {
+  class CodecBench {
+   public:
+    /// Usage: `<benchmark> [runs]`, each sample is run `runs` times
+    CodecBench(int argc, char **argv) {
+      if (argc > 1) {
+        std::string_view arg{argv[1]};
+        auto [_, ec] =
+            std::from_chars(arg.data(), arg.data() + arg.size(), runs_);
+        if (ec != std::errc{} or runs_ == 0) {
+          fmt::println(stderr, "usage: {} [runs]", argv[0]);
+          std::exit(EXIT_FAILURE);
+        }
+      }
+    }
+
+    /**
+     * Benchmark type with samples from codec test vectors, named after type
+     * (e.g. `work_report.bin` or `work_result_0.bin` for `WorkResult`).
+     */
+    template <typename T>
+    void common(std::string_view name, std::string_view file) {
+      const std::regex re{fmt::format("{}(_[0-9]+)?\\.bin", file)};
+      const std::pair<std::string_view, const Config &> sets[]{
+          {"data", config::tiny},
+          {"tiny", config::tiny},
+          {"full", config::full},
+      };
+      for (auto &[set, config] : sets) {
+        auto set_dir = dir / "codec" / set;
+        if (not std::filesystem::is_directory(set_dir)) {
+          continue;
+        }
+        std::vector<qtils::ByteVec> samples;
+        for (auto &entry : std::filesystem::directory_iterator{set_dir}) {
+          if (std::regex_match(entry.path().filename().string(), re)) {
+            samples.emplace_back(qtils::readBytes(entry.path()).value());
+          }
+        }
+        run<T>(fmt::format("{} ({})", name, set), config, samples);
+      }
+    }
+
+    /**
+     * Benchmark type of member of test case, with samples from test vectors
+     * of state transition.
+     */
+    template <typename Vectors, typename TestCase>
+    void member(std::string_view name, auto &&get) {
+      for (auto &vectors : Vectors::vectors()) {
+        const auto &config = vectors->config;
+        std::vector<qtils::ByteVec> samples;
+        for (auto &path : vectors->paths) {
+          auto raw = qtils::readBytes(path).value();
+          auto testcase = decode_with_config<TestCase>(raw, config).value();
+          samples.emplace_back(
+              encode_with_config(get(testcase), config).value());
+        }
+        if (samples.empty()) {
+          continue;
+        }
+        auto label = std::filesystem::relative(
+            vectors->paths.begin()->parent_path(), dir);
+        run<std::remove_cvref_t<decltype(get(std::declval<TestCase>()))>>(
+            fmt::format("{} ({})", name, label.string()), config, samples);
+      }
+    }
+
+   private:
+    template <typename T>
+    void run(const std::string &label,
+             const Config &config,
+             const std::vector<qtils::ByteVec> &samples) {
+      if (samples.empty()) {
+        return;
+      }
+      std::vector<T> values;
+      size_t bytes = 0;
+      for (auto &raw : samples) {
+        values.emplace_back(decode_with_config<T>(raw, config).value());
+        bytes += raw.size();
+      }
+      const auto n = samples.size();
+      const auto mean_bytes = static_cast<double>(bytes) / n;
+      auto throughput = [&](const BenchmarkResult &result) {
+        // bytes per nanosecond is GB/s
+        fmt::println("{:<48} {:>12.1f} MB/s",
+                     "",
+                     mean_bytes / result.time.count() * 1e3);
+      };
+      size_t i = 0;
+      throughput(benchmark(fmt::format("{} decode", label), n, runs_ * n, [&] {
+        doNotOptimize(decode_with_config<T>(samples[i++ % n], config).value());
+      }));
+      i = 0;
+      throughput(benchmark(fmt::format("{} encode", label), n, runs_ * n, [&] {
+        doNotOptimize(encode_with_config(values[i++ % n], config).value());
+      }));
+    }
+
+    size_t runs_ = 1000;
+  };
+}  // namespace jam::test_vectors
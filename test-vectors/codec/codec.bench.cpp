@@ -0,0 +1,87 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstdlib>
+#include <filesystem>
+#include <string_view>
+
+#include <fmt/format.h>
+#include <qtils/read_file.hpp>
+
+#include <jam_types/common-types.hpp>
+#include <jam_types/common-views.hpp>
+#include <jam_types/config-full.hpp>
+#include <jam_types/config-tiny.hpp>
+#include <scale/jam_scale.hpp>
+#include <test-vectors/benchmark.hpp>
+
+/**
+ * Encoding of block from codec test vectors: growing output vector, exact
+ * size reservation, and reused caller-provided buffer.
+ * Decoding of it: owning types and views borrowing fixed-size byte fields.
+ * Full config block is measured; if it is missing, tiny one is measured
+ * with warning, as its results do not represent full config.
+ */
+int main() {
+  using namespace jam::test_vectors;
+
+  const std::filesystem::path dir{PROJECT_SOURCE_DIR
+                                  "/test-vectors/jamtestvectors/codec"};
+  struct Candidate {
+    std::filesystem::path path;
+    std::string_view config_name;
+    Config config;
+  };
+  const Candidate candidates[]{
+      {dir / "full/block.bin", "full", config::full},
+      {dir / "tiny/block.bin", "tiny", config::tiny},
+      {dir / "data/block.bin", "tiny", config::tiny},
+  };
+  for (auto &[path, config_name, config] : candidates) {
+    if (not std::filesystem::exists(path)) {
+      continue;
+    }
+    if (&config != &candidates[0].config) {
+      fmt::println(stderr,
+                   "WARNING: full config block {} not found, measuring {} "
+                   "config block instead; results do not represent full "
+                   "config",
+                   candidates[0].path.native(),
+                   config_name);
+    }
+    auto raw = qtils::readBytes(path).value();
+    auto block = jam::decode_with_config<Block>(raw, config).value();
+    fmt::println(
+        "{}: {} bytes, {} config", path.native(), raw.size(), config_name);
+
+    benchmark("ToBytes into growing vector", 100, 10000, [&] {
+      std::vector<uint8_t> out;
+      scale::backend::ToBytes encoder(out, config);
+      jam::encode(block, encoder);
+      doNotOptimize(out);
+    });
+    benchmark("encoded_size", 100, 10000, [&] {
+      doNotOptimize(jam::encoded_size(block, config).value());
+    });
+    benchmark("encode_with_config (exact size)", 100, 10000, [&] {
+      doNotOptimize(jam::encode_with_config(block, config).value());
+    });
+    std::vector<uint8_t> buffer(raw.size());
+    benchmark("encode_into (reused buffer)", 100, 10000, [&] {
+      doNotOptimize(jam::encode_into(buffer, block, config).value());
+    });
+
+    benchmark("decode_with_config (owning)", 100, 10000, [&] {
+      doNotOptimize(jam::decode_with_config<Block>(raw, config).value());
+    });
+    benchmark("decode_borrowed (view)", 100, 10000, [&] {
+      doNotOptimize(jam::decode_borrowed<view::Block>(raw, config).value());
+    });
+    return EXIT_SUCCESS;
+  }
+  fmt::println(stderr, "block codec vector not found in {}", dir.native());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,93 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+#include <qtils/byte_arr.hpp>
+#include <qtils/bytes_std_hash.hpp>
+
+#include <test-vectors/benchmark.hpp>
+#include <utils/flat_hash_map.hpp>
+
+/**
+ * `jam::FlatHashMap` against `std::unordered_map` with `qtils::BytesStdHash`
+ * for 32-byte random keys: filling, lookup of present and absent keys, and
+ * erasing, for several sizes.
+ */
+
+using Key = qtils::ByteArr<32>;
+
+template <typename Map>
+void run(std::string_view name,
+         const std::vector<Key> &keys,
+         const std::vector<Key> &absent) {
+  using jam::test_vectors::benchmark;
+  using jam::test_vectors::doNotOptimize;
+  const auto n = keys.size();
+  const auto runs = std::max<size_t>(1, (1 << 20) / n);
+
+  benchmark(fmt::format("{} n={} fill", name, n), 1, runs, [&] {
+    Map map;
+    for (auto &key : keys) {
+      map[key] = 1;
+    }
+    doNotOptimize(map);
+  });
+
+  Map map;
+  for (auto &key : keys) {
+    map[key] = 1;
+  }
+  benchmark(fmt::format("{} n={} find hit", name, n), 1, runs, [&] {
+    size_t found = 0;
+    for (auto &key : keys) {
+      found += map.find(key) != map.end();
+    }
+    doNotOptimize(found);
+  });
+  benchmark(fmt::format("{} n={} find miss", name, n), 1, runs, [&] {
+    size_t found = 0;
+    for (auto &key : absent) {
+      found += map.find(key) != map.end();
+    }
+    doNotOptimize(found);
+  });
+  benchmark(fmt::format("{} n={} fill and erase", name, n), 1, runs, [&] {
+    Map map;
+    for (auto &key : keys) {
+      map[key] = 1;
+    }
+    for (auto &key : keys) {
+      map.erase(key);
+    }
+    doNotOptimize(map);
+  });
+}
+
+int main() {
+  std::mt19937_64 random{0};
+  auto random_keys = [&](size_t n) {
+    std::vector<Key> keys(n);
+    for (auto &key : keys) {
+      for (auto &byte : key) {
+        byte = static_cast<uint8_t>(random());
+      }
+    }
+    return keys;
+  };
+  for (size_t n : {64, 1024, 65536}) {
+    auto keys = random_keys(n);
+    auto absent = random_keys(n);
+    run<std::unordered_map<Key, int, qtils::BytesStdHash>>(
+        "std::unordered_map", keys, absent);
+    run<jam::FlatHashMap<Key, int>>("jam::FlatHashMap", keys, absent);
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,206 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <qtils/byte_vec.hpp>
+
+#include <storage/bytes_compare.hpp>
+#include <storage/in_memory/in_memory_storage.hpp>
+#include <test-vectors/benchmark.hpp>
+
+/**
+ * `storage::InMemoryStorage` keyed by bytes against previous engine, which
+ * kept entries in `std::map` keyed by hex strings (reproduced here by
+ * `HexMap`), and against the same ordered map without hash index
+ * (`OrderedMap`): heap bytes held per entry, put, get of present and absent
+ * keys, and full cursor scan, for 32-byte random keys and 64-byte values.
+ */
+
+using jam::storage::ByteVec;
+using jam::storage::ByteView;
+
+/// Operations of previous engine, with the same key conversions
+struct HexMap {
+  void put(const ByteView &key, const ByteVec &value) {
+    storage_[key.toHex()] = value;
+  }
+
+  std::optional<ByteView> get(const ByteView &key) const {
+    if (storage_.find(key.toHex()) != storage_.end()) {
+      return ByteView{storage_.at(key.toHex())};
+    }
+    return std::nullopt;
+  }
+
+  size_t scan() const {
+    size_t n = 0;
+    for (auto it = storage_.begin(); it != storage_.end();
+         it = storage_.upper_bound(it->first)) {
+      auto key = ByteVec::fromHex(it->first).value();
+      n += key.size() + it->second.size();
+    }
+    return n;
+  }
+
+  std::map<std::string, ByteVec> storage_;
+};
+
+/// Ordered map of `InMemoryStorage` without its hash index
+struct OrderedMap {
+  void put(const ByteView &key, const ByteVec &value) {
+    auto it = storage_.find(key);
+    if (it != storage_.end()) {
+      it->second = value;
+      return;
+    }
+    storage_.emplace(ByteVec(key.begin(), key.end()), value);
+  }
+
+  std::optional<ByteView> get(const ByteView &key) const {
+    auto it = storage_.find(key);
+    if (it != storage_.end()) {
+      return ByteView{it->second};
+    }
+    return std::nullopt;
+  }
+
+  std::map<ByteVec, ByteVec, jam::storage::BytesLess> storage_;
+};
+
+/// Heap bytes per entry held by container filled by `fill`
+template <typename T>
+double bytesPerEntry(size_t n, auto &&fill) {
+  using jam::test_vectors::allocated_bytes;
+  auto before = allocated_bytes.load();
+  auto container = std::make_unique<T>();
+  fill(*container);
+  return static_cast<double>(allocated_bytes.load() - before) / n;
+}
+
+int main() {
+  using jam::test_vectors::benchmark;
+  using jam::test_vectors::doNotOptimize;
+
+  std::mt19937_64 random{0};
+  auto random_bytes = [&](size_t size) {
+    ByteVec bytes(size);
+    for (auto &byte : bytes) {
+      byte = static_cast<uint8_t>(random());
+    }
+    return bytes;
+  };
+
+  for (size_t n : {1024, 65536}) {
+    std::vector<ByteVec> keys, absent, values;
+    for (size_t i = 0; i < n; ++i) {
+      keys.emplace_back(random_bytes(32));
+      absent.emplace_back(random_bytes(32));
+      values.emplace_back(random_bytes(64));
+    }
+    const auto runs = std::max<size_t>(1, (1 << 20) / n);
+
+    fmt::println("{:<48} {:>12.1f} bytes/entry",
+                 fmt::format("hex map n={} memory", n),
+                 bytesPerEntry<HexMap>(n, [&](HexMap &map) {
+                   for (size_t i = 0; i < n; ++i) {
+                     map.put(keys[i], values[i]);
+                   }
+                 }));
+    fmt::println("{:<48} {:>12.1f} bytes/entry",
+                 fmt::format("ordered map n={} memory", n),
+                 bytesPerEntry<OrderedMap>(n, [&](OrderedMap &map) {
+                   for (size_t i = 0; i < n; ++i) {
+                     map.put(keys[i], values[i]);
+                   }
+                 }));
+    fmt::println(
+        "{:<48} {:>12.1f} bytes/entry",
+        fmt::format("InMemoryStorage n={} memory", n),
+        bytesPerEntry<jam::storage::InMemoryStorage>(
+            n, [&](jam::storage::InMemoryStorage &db) {
+              for (size_t i = 0; i < n; ++i) {
+                db.put(keys[i], ByteView{values[i]}).value();
+              }
+            }));
+
+    benchmark(fmt::format("hex map n={} put", n), 1, runs, [&] {
+      HexMap map;
+      for (size_t i = 0; i < n; ++i) {
+        map.put(keys[i], values[i]);
+      }
+      doNotOptimize(map);
+    });
+    benchmark(fmt::format("ordered map n={} put", n), 1, runs, [&] {
+      OrderedMap map;
+      for (size_t i = 0; i < n; ++i) {
+        map.put(keys[i], values[i]);
+      }
+      doNotOptimize(map);
+    });
+    benchmark(fmt::format("InMemoryStorage n={} put", n), 1, runs, [&] {
+      jam::storage::InMemoryStorage db;
+      for (size_t i = 0; i < n; ++i) {
+        db.put(keys[i], ByteView{values[i]}).value();
+      }
+      doNotOptimize(db);
+    });
+
+    HexMap map;
+    OrderedMap ordered;
+    jam::storage::InMemoryStorage db;
+    for (size_t i = 0; i < n; ++i) {
+      map.put(keys[i], values[i]);
+      ordered.put(keys[i], values[i]);
+      db.put(keys[i], ByteView{values[i]}).value();
+    }
+    for (auto [name, probe] : {std::pair{"hit", &keys}, {"miss", &absent}}) {
+      benchmark(fmt::format("hex map n={} get {}", n, name), 1, runs, [&] {
+        size_t found = 0;
+        for (auto &key : *probe) {
+          found += map.get(key).has_value();
+        }
+        doNotOptimize(found);
+      });
+      benchmark(
+          fmt::format("ordered map n={} get {}", n, name), 1, runs, [&] {
+            size_t found = 0;
+            for (auto &key : *probe) {
+              found += ordered.get(key).has_value();
+            }
+            doNotOptimize(found);
+          });
+      benchmark(
+          fmt::format("InMemoryStorage n={} get {}", n, name), 1, runs, [&] {
+            size_t found = 0;
+            for (auto &key : *probe) {
+              found += db.tryGet(key).value().has_value();
+            }
+            doNotOptimize(found);
+          });
+    }
+
+    benchmark(fmt::format("hex map n={} scan", n), 1, runs, [&] {
+      doNotOptimize(map.scan());
+    });
+    benchmark(fmt::format("InMemoryStorage n={} scan", n), 1, runs, [&] {
+      size_t bytes = 0;
+      auto cursor = db.cursor();
+      for (cursor->seekFirst().value(); cursor->isValid();
+           cursor->next().value()) {
+        bytes += cursor->key()->size() + cursor->value()->size();
+      }
+      doNotOptimize(bytes);
+    });
+  }
+  return EXIT_SUCCESS;
+}
@@ -16,6 +16,9 @@
 #include <qtils/empty.hpp>
 #include <qtils/hex.hpp>
 #include <qtils/tagged.hpp>
+#include <test-vectors/hashed.hpp>
+#include <test-vectors/interned.hpp>
+#include <test-vectors/ring-buffer.hpp>
 
 /**
  * Print colorful diff for objects.
@@ -87,6 +90,16 @@ DIFF_F(qtils::Tagged<T, Tag>) {
   diff(indent, untagged(v1), untagged(v2));
 }
 
+template <typename T>
+DIFF_F(jam::Hashed<T>) {
+  diff(indent, v1.value(), v2.value());
+}
+
+template <typename T>
+DIFF_F(jam::Interned<T>) {
+  diff(indent, v1.value(), v2.value());
+}
+
 template <typename T>
 DIFF_F(std::optional<T>) {
   if (v1 == v2) {
@@ -127,6 +140,25 @@ void diff(Indent indent, const T &_v1, const T &_v2) {
   }
 }
 
+template <typename T, size_t N>
+DIFF_F(jam::RingBuffer<T, N>) {
+  if (v1 == v2) {
+    return;
+  }
+  if (v1.size() != v2.size()) {
+    fmt::println("{}{} != {}", indent, v1.size(), v2.size());
+    return;
+  }
+  fmt::println("{}{}", indent, v1.size());
+  for (size_t i = 0; i < v1.size(); ++i) {
+    if (v1[i] == v2[i]) {
+      continue;
+    }
+    fmt::println("{}[{}]", indent, i);
+    diff(~indent, v1[i], v2[i]);
+  }
+}
+
 void diff(Indent indent, const qtils::BytesIn &v1, const qtils::BytesIn &v2) {
   if (v1.size() == v2.size() && memcmp(v1.data(), v2.data(), v1.size()) == 0) {
     return;
@@ -7,10 +7,10 @@
 #pragma once
 
 #include <map>
+#include <memory_resource>
 #include <ranges>
 #include <set>
 
-#include <qtils/bytes_std_hash.hpp>
 #include <qtils/cxx23/ranges/contains.hpp>
 #include <qtils/append.hpp>
 
@@ -19,12 +19,14 @@
 #include <jam_types/common-types.hpp>
 #include <test-vectors/common.hpp>
 #include <jam_types/disputes-types.hpp>
+#include <utils/flat_hash_map.hpp>
 
 namespace jam::disputes {
   namespace types = jam::test_vectors;
 
-  auto asSet(auto &&r) {
-    return std::set(r.begin(), r.end());
+  auto asSet(auto &&r, std::pmr::memory_resource *arena) {
+    using T = std::ranges::range_value_t<decltype(r)>;
+    return std::pmr::set<T>(r.begin(), r.end(), arena);
   }
 
   auto asVec(auto &&r) {
@@ -96,10 +98,12 @@ namespace jam::disputes {
       'j', 'a', 'm', '_', 'g', 'u', 'a', 'r', 'a', 'n', 't', 'e', 'e'};
 
   /// Given state and input, derive next state and output.
+  /// Temporary containers are allocated from `arena`.
   inline std::pair<types::disputes::State, types::disputes::Output> transition(
       const types::Config &config,
       const types::disputes::State &state,
-      const types::disputes::Input &input) {
+      const types::disputes::Input &input,
+      std::pmr::memory_resource *arena = std::pmr::get_default_resource()) {
     using Error = types::disputes::ErrorCode;
     const auto error = [&](Error error) {
       return std::make_pair(state, types::disputes::Output{error});
@@ -149,21 +153,19 @@ namespace jam::disputes {
     auto current_epoch = state.tau / config.epoch_length;
 
     // к - kappa, aka validator set of current epoch
-    const auto &current_epoch_validator_set = state.kappa;
+    const auto &current_epoch_validator_set = *state.kappa;
 
     auto previous_epoch =
         current_epoch ? current_epoch - 1
                       : 0;  // For using copy of epoch 0 as of previous one
 
     // λ - lambda, aka validator set of previous epoch
-    const auto &previous_epoch_validator_set = state.lambda;
+    const auto &previous_epoch_validator_set = *state.lambda;
 
     // Verdicts for registration
-    std::vector<types::Verdict> verdicts_registry;
-    std::unordered_multimap<types::WorkReportHash,
-                            std::reference_wrapper<const types::Judgement>,
-                            qtils::BytesStdHash>
-        judgements_registry;
+    std::pmr::vector<types::Verdict> verdicts_registry{arena};
+    pmr::FlatHashMap<types::WorkReportHash, std::pair<types::U16, types::U16>>
+        vote_count_by_judgements{arena};
 
     // Check verdicts.
     // The signatures of all judgments must be valid in terms of one of the two
@@ -237,20 +239,22 @@ namespace jam::disputes {
         auto in_wonky = qtils::cxx23::ranges::contains(wonky_set, work_report);
         if (not in_bad and not in_good and not in_wonky) {
           verdicts_registry.push_back(verdict);
+          auto &[voted_for, voted_against] =
+              vote_count_by_judgements[work_report];
           for (const auto &judgement : judgements) {
-            judgements_registry.emplace(work_report, std::ref(judgement));
+            ++(judgement.vote ? voted_for : voted_against);
           }
         }
       }
     }
 
-    std::multimap<types::WorkReportHash,
-                  std::reference_wrapper<const types::Culprit>,
-                  std::less<>
-                  // std::equal_to<>
-                  //  hash_range<types::WorkReportHash>
-                  >
-        culprits_registry;
+    std::pmr::multimap<types::WorkReportHash,
+                       std::reference_wrapper<const types::Culprit>,
+                       std::less<>
+                       // std::equal_to<>
+                       //  hash_range<types::WorkReportHash>
+                       >
+        culprits_registry{arena};
 
     // Check culprits
     {
@@ -303,12 +307,12 @@ namespace jam::disputes {
       }
     }
 
-    std::multimap<types::WorkReportHash,
-                  std::reference_wrapper<const types::Fault>,
-                  std::less<>
-                  // hash_range<types::WorkReportHash>
-                  >
-        faults_registry;
+    std::pmr::multimap<types::WorkReportHash,
+                       std::reference_wrapper<const types::Fault>,
+                       std::less<>
+                       // hash_range<types::WorkReportHash>
+                       >
+        faults_registry{arena};
 
     // Check faults
     {
@@ -373,16 +377,6 @@ namespace jam::disputes {
       }
     }
 
-    std::unordered_map<types::WorkReportHash,
-                       std::pair<types::U16, types::U16>,
-                       qtils::BytesStdHash>
-        vote_count_by_judgements;
-
-    for (const auto &[work_report, judgement] : judgements_registry) {
-      auto &[voted_for, voted_against] = vote_count_by_judgements[work_report];
-      ++(judgement.get().vote ? voted_for : voted_against);
-    }
-
     // Check culprits one more time, for orphan and non-bad culprits
     for (const auto &work_report : culprits_registry | std::views::keys) {
       auto it = vote_count_by_judgements.find(work_report);
@@ -397,25 +391,25 @@ namespace jam::disputes {
 
     // ψ'g - set of work-reports which were judged as correct
     // [GP 0.4.5 10.2 (112)]
-    auto new_good_set = asSet(good_set);
+    auto new_good_set = asSet(good_set, arena);
 
     // ψ'b - set of work-reports which were judged as incorrect
     // [GP 0.4.5 10.2 (113)]
-    auto new_bad_set = asSet(bad_set);
+    auto new_bad_set = asSet(bad_set, arena);
 
     // ψ'w - set of work-reports which were appeared impossible to judge
     // [GP 0.4.5 10.2 (114)]
-    auto new_wonky_set = asSet(wonky_set);
+    auto new_wonky_set = asSet(wonky_set, arena);
 
     // ψ'o - a set of Ed25519 keys representing validators which were found to
     // have misjudged a work-report
     // [GP 0.4.5 10.2 (115)]
-    auto new_punish_set = asSet(punish_set);
+    auto new_punish_set = asSet(punish_set, arena);
 
     // The offenders markers must contain exactly the keys of all new offenders,
     // respectively
     // [GP 0.4.5 10.2 (116)]
-    std::vector<types::Ed25519Public> offenders_mark;
+    std::pmr::vector<types::Ed25519Public> offenders_mark{arena};
 
     // Analise verdicts
     for (const auto &[work_report, counts] : vote_count_by_judgements) {
@@ -494,8 +488,8 @@ namespace jam::disputes {
     // [GP 0.4.5 10.2 (111)]
     for (auto &row_work_report : work_reports) {
       if (row_work_report.has_value()) {
-        auto work_report = mathcal_H(
-            encode_with_config(row_work_report.value().report, config).value());
+        // Hash is computed once, when report is placed into ρ
+        const auto &work_report = row_work_report.value().report.hash();
         if (new_bad_set.contains(work_report)
             or new_wonky_set.contains(work_report)) {
           row_work_report.reset();
@@ -0,0 +1,12 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <jam_types/disputes-types.hpp>
+#include <test-vectors/disputes/disputes.hpp>
+#include <test-vectors/disputes/vectors.hpp>
+#include <test-vectors/replay.hpp>
+
+BENCHMARK_VECTORS_REPLAY(disputes)
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <jam_types/disputes-types-full.hpp>
+#include <jam_types/disputes-types-tiny.hpp>
 #include <test-vectors/disputes/vectors.hpp>
 
 GTEST_VECTORS(Disputes, disputes);
@@ -12,3 +14,8 @@ GTEST_VECTORS(Disputes, disputes);
  * Check python generated scale encoding/decoding against test vectors.
  */
 GTEST_VECTORS_TEST_REENCODE(Disputes, disputes);
+
+/**
+ * Check types specialized for constant sets against test vectors.
+ */
+GTEST_VECTORS_TEST_REENCODE_SPECIALIZED(Disputes, disputes);
@@ -0,0 +1,69 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <crypto/blake.hpp>
+#include <jam_types/config.hpp>
+#include <scale/jam_scale.hpp>
+
+namespace jam {
+  /**
+   * Value together with blake2b hash of its encoding.
+   * Hash is computed once, when value is placed (constructed or decoded), and
+   * is not a part of encoding.
+   * Encoding is streamed into hasher, without intermediate buffer.
+   */
+  template <typename T>
+  class Hashed {
+   public:
+    using Hash = crypto::Blake::Hash;
+
+    Hashed() = default;
+
+    Hashed(T value, const test_vectors::Config &config)
+        : value_{std::move(value)} {
+      rehash(config);
+    }
+
+    const T &value() const {
+      return value_;
+    }
+
+    const T &operator*() const {
+      return value_;
+    }
+
+    const T *operator->() const {
+      return &value_;
+    }
+
+    const Hash &hash() const {
+      return hash_;
+    }
+
+    bool operator==(const Hashed &other) const {
+      return value_ == other.value_;
+    }
+
+    friend void encode(const Hashed &v, scale::Encoder &encoder) {
+      encode(v.value_, encoder);
+    }
+
+    friend void decode(Hashed &v, scale::Decoder &decoder) {
+      decode(v.value_, decoder);
+      v.rehash(decoder.template getConfig<test_vectors::Config>());
+    }
+
+   private:
+    void rehash(const test_vectors::Config &config) {
+      hash_ = hash_encoded<crypto::Blake>(value_, config).value();
+    }
+
+    T value_;
+    Hash hash_{};
+  };
+}  // namespace jam
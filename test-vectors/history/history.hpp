@@ -6,11 +6,10 @@
 
 #pragma once
 
-#include <qtils/option_take.hpp>
-
-#include <test-vectors/common.hpp>
 #include <jam_types/common-types.hpp>
 #include <jam_types/history-types.hpp>
+#include <test-vectors/common.hpp>
+#include <test-vectors/history/mmr.hpp>
 
 namespace jam::history {
   namespace types = jam::test_vectors;
@@ -22,51 +21,48 @@ namespace jam::history {
   // https://github.com/gavofyork/graypaper/blob/v0.4.5/text/definitions.tex#L266
   constexpr uint32_t H = 8;
 
-  // [GP 0.4.5 E.2 333]
-  // https://github.com/gavofyork/graypaper/blob/v0.4.5/text/merklization.tex#L205
-  inline types::Mmr mathcal_A(types::Mmr r, types::OpaqueHash l) {
-    for (size_t n = 0; n < r.peaks.size(); ++n) {
-      if (not r.peaks[n]) {
-        r.peaks[n] = l;
-        return r;
-      }
-      auto r_n = qtils::optionTake(r.peaks[n]).value();
-      l = mathcal_H_K(frown(r_n, l));
-    }
-    r.peaks.emplace_back(l);
-    return r;
-  }
-
   /**
-   * Given state and input, derive next state and output.
+   * Given input, derive next state in place and return output.
    */
-  inline std::pair<types::history::State, types::history::Output> transition(
+  inline types::history::Output transition_in_place(
       const types::Config & /*config*/,
-      const types::history::State &state,
+      types::history::State &state,
       const types::history::Input &input) {
+    auto &beta = state.beta;
+    static_assert(H <= std::remove_cvref_t<decltype(beta)>::capacity());
     // [GP 0.4.5 7 84]
     // https://github.com/gavofyork/graypaper/blob/v0.4.5/text/recent_history.tex#L32
-    std::vector beta_tick(state.beta.size() >= H ? std::next(state.beta.begin())
-                                                 : state.beta.begin(),
-                          state.beta.end());
-    // [GP 0.4.5 7 82]
-    // https://github.com/gavofyork/graypaper/blob/v0.4.5/text/recent_history.tex#L12
-    if (not beta_tick.empty()) {
-      beta_tick.back().state_root = input.parent_state_root;
+    if (beta.size() >= H) {
+      beta.pop_front();
     }
     // [GP 0.4.5 7 83]
     // https://github.com/gavofyork/graypaper/blob/v0.4.5/text/recent_history.tex#L20
-    types::Mmr mmr;
-    if (not state.beta.empty()) {
-      mmr = state.beta.back().mmr;
+    types::Mmr mmr_tick;
+    if (not beta.empty()) {
+      // [GP 0.4.5 7 82]
+      // https://github.com/gavofyork/graypaper/blob/v0.4.5/text/recent_history.tex#L12
+      beta.back().state_root = input.parent_state_root;
+      mmr_tick = beta.back().mmr;
     }
-    auto mmr_tick = mathcal_A(mmr, input.accumulate_root);
-    beta_tick.emplace_back(types::BlockInfo{
+    mathcal_A(mmr_tick, input.accumulate_root);
+    beta.push_back(types::BlockInfo{
         .header_hash = input.header_hash,
-        .mmr = mmr_tick,
+        .mmr = std::move(mmr_tick),
         .state_root = types::StateRoot{},
         .reported = input.work_packages,
     });
-    return std::make_pair(types::history::State{.beta = beta_tick}, types::history::Output{});
+    return types::history::Output{};
+  }
+
+  /**
+   * Given state and input, derive next state and output.
+   */
+  inline std::pair<types::history::State, types::history::Output> transition(
+      const types::Config &config,
+      const types::history::State &state,
+      const types::history::Input &input) {
+    auto state_tick = state;
+    auto output = transition_in_place(config, state_tick, input);
+    return std::make_pair(std::move(state_tick), std::move(output));
   }
 }  // namespace jam::history
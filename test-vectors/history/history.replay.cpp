@@ -0,0 +1,12 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <jam_types/history-types.hpp>
+#include <test-vectors/history/history.hpp>
+#include <test-vectors/history/vectors.hpp>
+#include <test-vectors/replay.hpp>
+
+BENCHMARK_VECTORS_REPLAY(history)
@@ -0,0 +1,60 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <optional>
+
+#include <qtils/option_take.hpp>
+
+#include <crypto/keccak.hpp>
+#include <jam_types/common-types.hpp>
+#include <test-vectors/common.hpp>
+
+namespace jam::history {
+  namespace types = jam::test_vectors;
+
+  // [GP 0.4.5 E.2 333]
+  // https://github.com/gavofyork/graypaper/blob/v0.4.5/text/merklization.tex#L205
+  // Appends leaf in place, rehashing only the O(log n) merged peaks.
+  inline void mathcal_A(types::Mmr &r, types::OpaqueHash l) {
+    for (size_t n = 0; n < r.peaks.size(); ++n) {
+      if (not r.peaks[n]) {
+        r.peaks[n] = l;
+        return;
+      }
+      auto r_n = qtils::optionTake(r.peaks[n]).value();
+      l = mathcal_H_K(frown(r_n, l));
+    }
+    r.peaks.emplace_back(l);
+  }
+
+  // [GP 0.4.5 E.2]
+  // $peak - prefix of MMR super-peak hashing
+  constexpr qtils::ByteArr<4> kPeak{'p', 'e', 'a', 'k'};
+
+  // [GP 0.4.5 E.2 334]
+  // https://github.com/gavofyork/graypaper/blob/v0.4.5/text/merklization.tex#L214
+  // Super-peak of MMR, i.e. commitment to all its leaves.
+  inline types::OpaqueHash mathcal_M_R(const types::Mmr &b) {
+    std::optional<types::OpaqueHash> root;
+    // h = [h | h <- b, h != ∅]
+    // M_R(h) = H_K($peak ⌢ M_R(h_{..|h|-1}) ⌢ h_{|h|-1}), i.e. left fold
+    // starting from h_0, the lowest peak
+    for (auto it = b.peaks.begin(); it != b.peaks.end(); ++it) {
+      if (not *it) {
+        continue;
+      }
+      root = root ? crypto::Keccak{}
+                        .update(kPeak)
+                        .update(*root)
+                        .update(**it)
+                        .hash()
+                  : **it;
+    }
+    return root.value_or(types::OpaqueHash{});
+  }
+}  // namespace jam::history
@@ -0,0 +1,81 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <qtils/byte_vec.hpp>
+
+#include <test-vectors/history/mmr.hpp>
+
+using jam::history::mathcal_A;
+using jam::history::mathcal_M_R;
+using jam::test_vectors::Mmr;
+using jam::test_vectors::OpaqueHash;
+
+OpaqueHash leaf(uint8_t i) {
+  OpaqueHash hash{};
+  hash[0] = i;
+  return hash;
+}
+
+OpaqueHash node(const OpaqueHash &left, const OpaqueHash &right) {
+  return jam::mathcal_H_K(jam::frown(left, right));
+}
+
+qtils::ByteVec bytes(const OpaqueHash &hash) {
+  return {hash.begin(), hash.end()};
+}
+
+/**
+ * @given empty MMR
+ * @when append 7 leaves in place
+ * @then peaks are merged as in [GP 0.4.5 E.2 333]
+ */
+TEST(Mmr, Append) {
+  Mmr mmr;
+  for (uint8_t i = 0; i < 7; ++i) {
+    mathcal_A(mmr, leaf(i));
+  }
+  auto l01 = node(leaf(0), leaf(1));
+  auto l23 = node(leaf(2), leaf(3));
+  EXPECT_EQ(mmr.peaks,
+            (decltype(mmr.peaks){
+                leaf(6), node(leaf(4), leaf(5)), node(l01, l23)}));
+
+  mathcal_A(mmr, leaf(7));
+  auto l4567 = node(node(leaf(4), leaf(5)), node(leaf(6), leaf(7)));
+  auto l01234567 = node(node(l01, l23), l4567);
+  EXPECT_EQ(mmr.peaks,
+            (decltype(mmr.peaks){
+                std::nullopt, std::nullopt, std::nullopt, l01234567}));
+}
+
+/**
+ * @given MMRs with two and three non-empty peaks
+ * @when compute super-peak
+ * @then it is left fold from lowest peak, as in [GP 0.4.5 E.2 334]
+ */
+TEST(Mmr, SuperPeak) {
+  Mmr mmr;
+  for (uint8_t i = 0; i < 7; ++i) {
+    mathcal_A(mmr, leaf(i));
+    if (i == 2) {
+      // peaks [l2, H(l0 ⌢ l1)]
+      // H_K($peak ⌢ l2 ⌢ H(l0 ⌢ l1))
+      EXPECT_EQ(bytes(mathcal_M_R(mmr)),
+                qtils::ByteVec::fromHex("48e944958d9d60042711e83f116dd46b"
+                                        "f4aec2ea6e36577f3d06dfc4ab93dd4a")
+                    .value());
+    }
+  }
+  // peaks [l6, H(l4 ⌢ l5), H(H(l0 ⌢ l1) ⌢ H(l2 ⌢ l3))]
+  // H_K($peak ⌢ H_K($peak ⌢ h_0 ⌢ h_1) ⌢ h_2)
+  EXPECT_EQ(bytes(mathcal_M_R(mmr)),
+            qtils::ByteVec::fromHex("5af6964dc96a30d4ff1689c8454f81d9"
+                                    "79737e7bb194bd9afbed097b086541d8")
+                .value());
+  EXPECT_EQ(mathcal_M_R(Mmr{}), OpaqueHash{});
+}
@@ -0,0 +1,165 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+#include <crypto/blake.hpp>
+#include <jam_types/config.hpp>
+#include <scale/jam_scale.hpp>
+#include <utils/flat_hash_map.hpp>
+
+namespace jam {
+  /**
+   * Number of distinct values of type kept alive by `Interned`.
+   */
+  struct InternedStats {
+    size_t values = 0;
+    /// Total size of their encodings
+    size_t encoded_bytes = 0;
+  };
+
+  /**
+   * Immutable value, shared by all equal instances.
+   * Values are identified by blake2b hash of their encoding and kept in
+   * process-wide pool while referenced, so copying is copying of pointer
+   * (e.g. rotation of validator sets κ → λ on epoch change).
+   * Encoding is streamed into hasher when value is placed (constructed or
+   * decoded) and not kept, pool entry holds only value and its hash.
+   * Default-constructed instance holds `T{}` and is not pooled.
+   */
+  template <typename T>
+  class Interned {
+    struct Entry {
+      T value;
+      size_t encoded_size = 0;
+      crypto::Blake::Hash hash;
+    };
+
+   public:
+    using Value = T;
+    using Hash = crypto::Blake::Hash;
+
+    Interned() = default;
+
+    Interned(T value, const test_vectors::Config &config) {
+      auto entry = std::make_unique<Entry>();
+      entry->value = std::move(value);
+      entry_ = intern(std::move(entry), config);
+    }
+
+    const T &value() const {
+      return entry_ ? entry_->value : empty();
+    }
+
+    const T &operator*() const {
+      return value();
+    }
+
+    const T *operator->() const {
+      return &value();
+    }
+
+    /// Hash of encoding, zero for default-constructed instance
+    const Hash &hash() const {
+      static const Hash kZero{};
+      return entry_ ? entry_->hash : kZero;
+    }
+
+    /// Number of instances sharing value
+    long useCount() const {
+      return entry_.use_count();
+    }
+
+    bool operator==(const Interned &other) const {
+      if (entry_ == other.entry_) {
+        return true;
+      }
+      if (entry_ and other.entry_) {
+        return entry_->hash == other.entry_->hash;
+      }
+      return value() == other.value();
+    }
+
+    static InternedStats stats() {
+      auto &pool = Pool::get();
+      std::lock_guard lock{pool.mutex};
+      return pool.stats;
+    }
+
+    friend void encode(const Interned &v, scale::Encoder &encoder) {
+      encode(v.value(), encoder);
+    }
+
+    friend void decode(Interned &v, scale::Decoder &decoder) {
+      // Decoded in place, value may be large (e.g. `std::array`)
+      auto entry = std::make_unique<Entry>();
+      decode(entry->value, decoder);
+      v.entry_ = intern(std::move(entry),
+                        decoder.template getConfig<test_vectors::Config>());
+    }
+
+   private:
+    struct Pool {
+      static Pool &get() {
+        // Leaked, values may outlive static destruction
+        static auto *pool = new Pool;
+        return *pool;
+      }
+
+      std::mutex mutex;
+      FlatHashMap<Hash, std::weak_ptr<const Entry>> entries;
+      InternedStats stats;
+    };
+
+    static const T &empty() {
+      static const T kEmpty{};
+      return kEmpty;
+    }
+
+    /// Return pooled entry equal to `entry`, or pool `entry` itself
+    static std::shared_ptr<const Entry> intern(
+        std::unique_ptr<Entry> entry, const test_vectors::Config &config) {
+      crypto::Blake hasher;
+      HashingEncoder encoder{hasher, config};
+      encode(entry->value, encoder);
+      encoder.flush();
+      entry->encoded_size = encoder.size();
+      entry->hash = hasher.hash();
+      auto &pool = Pool::get();
+      std::lock_guard lock{pool.mutex};
+      auto &slot = pool.entries[entry->hash];
+      if (auto pooled = slot.lock()) {
+        return pooled;
+      }
+      pool.stats.values += 1;
+      pool.stats.encoded_bytes += entry->encoded_size;
+      std::shared_ptr<const Entry> pooled{
+          entry.release(),
+          [](const Entry *entry) {
+            auto &pool = Pool::get();
+            {
+              std::lock_guard lock{pool.mutex};
+              pool.stats.values -= 1;
+              pool.stats.encoded_bytes -= entry->encoded_size;
+              // Slot may be already taken by new entry with the same hash
+              auto it = pool.entries.find(entry->hash);
+              if (it != pool.entries.end() and it->second.expired()) {
+                pool.entries.erase(it);
+              }
+            }
+            delete entry;
+          }};
+      slot = pooled;
+      return pooled;
+    }
+
+    std::shared_ptr<const Entry> entry_;
+  };
+}  // namespace jam
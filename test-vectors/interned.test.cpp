@@ -0,0 +1,99 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <jam_types/config-tiny.hpp>
+#include <test-vectors/interned.hpp>
+
+using jam::Interned;
+using Values = std::vector<uint32_t>;
+using InternedValues = Interned<Values>;
+
+class InternedTest : public testing::Test {
+ public:
+  const jam::test_vectors::Config &config = jam::test_vectors::config::tiny;
+  const Values values1{1, 2, 3};
+  const Values values2{4, 5};
+};
+
+/**
+ * @given value interned twice
+ * @when instances are compared
+ * @then both share one pooled entry
+ */
+TEST_F(InternedTest, EqualValuesShareEntry) {
+  auto before = InternedValues::stats().values;
+  InternedValues a{values1, config};
+  InternedValues b{values1, config};
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(&a.value(), &b.value());
+  EXPECT_EQ(a.useCount(), 2);
+  EXPECT_EQ(InternedValues::stats().values, before + 1);
+
+  InternedValues c{values2, config};
+  EXPECT_NE(a, c);
+  EXPECT_NE(a.hash(), c.hash());
+  EXPECT_EQ(*c, values2);
+  EXPECT_EQ(InternedValues::stats().values, before + 2);
+}
+
+/**
+ * @given interned value
+ * @when all instances are destroyed
+ * @then entry is erased from pool, and value is pooled again on next use
+ */
+TEST_F(InternedTest, EntryExpires) {
+  auto before = InternedValues::stats();
+  auto encoded = jam::encode_with_config(values1, config).value();
+  {
+    InternedValues a{values1, config};
+    auto copy = a;
+    EXPECT_EQ(copy.useCount(), 2);
+    auto stats = InternedValues::stats();
+    EXPECT_EQ(stats.values, before.values + 1);
+    EXPECT_EQ(stats.encoded_bytes, before.encoded_bytes + encoded.size());
+  }
+  auto after = InternedValues::stats();
+  EXPECT_EQ(after.values, before.values);
+  EXPECT_EQ(after.encoded_bytes, before.encoded_bytes);
+
+  InternedValues a{values1, config};
+  EXPECT_EQ(a.useCount(), 1);
+  EXPECT_EQ(*a, values1);
+}
+
+/**
+ * @given interned value
+ * @when it is encoded and decoded
+ * @then encoding is that of plain value, and decoded instance shares entry
+ * with original
+ */
+TEST_F(InternedTest, DecodeSharesEntry) {
+  InternedValues a{values1, config};
+  auto encoded = jam::encode_with_config(a, config).value();
+  EXPECT_EQ(encoded, jam::encode_with_config(values1, config).value());
+  EXPECT_EQ(a.hash(), jam::crypto::Blake::hash(encoded));
+
+  auto b = jam::decode_with_config<InternedValues>(encoded, config).value();
+  EXPECT_EQ(&a.value(), &b.value());
+  EXPECT_EQ(b.useCount(), 2);
+}
+
+/**
+ * @given default-constructed instance
+ * @when it is inspected
+ * @then it holds empty value, zero hash, and is not pooled
+ */
+TEST_F(InternedTest, DefaultIsNotPooled) {
+  auto before = InternedValues::stats().values;
+  InternedValues a;
+  EXPECT_TRUE(a->empty());
+  EXPECT_EQ(a.hash(), InternedValues::Hash{});
+  EXPECT_EQ(a.useCount(), 0);
+  EXPECT_EQ(a, InternedValues{});
+  EXPECT_EQ(InternedValues::stats().values, before);
+}
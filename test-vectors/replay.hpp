@@ -0,0 +1,129 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <charconv>
+#include <cstdlib>
+#include <filesystem>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <qtils/read_file.hpp>
+#include <scale/jam_scale.hpp>
+#include <test-vectors/benchmark.hpp>
+
+/**
+ * Replay all test vectors of state transition as benchmark.
+ * Usage: `<benchmark> [runs]`, each case is run `runs` times (100 by default)
+ * after warm-up; results are means over all cases of config.
+ * Transitions accepting `std::pmr::memory_resource` are also measured with
+ * monotonic arena, released after each run.
+ */
+#define BENCHMARK_VECTORS_REPLAY(NsPart)                                \
+  int main(int argc, char **argv) {                                     \
+    return jam::test_vectors::replay<                                   \
+        jam::test_vectors::NsPart::Vectors,                             \
+        jam::test_vectors::NsPart::TestCase>(                           \
+        argc,                                                           \
+        argv,                                                           \
+        [](auto &config, auto &state, auto &input, auto... arena)       \
+          requires requires {                                           \
+            jam::NsPart::transition(config, state, input, arena...);    \
+          }                                                             \
+        {                                                               \
+          return jam::NsPart::transition(config, state, input, arena...); \
+        });                                                             \
+  }
+
+namespace jam::test_vectors {
+  /**
+   * Preload all vectors files of every config, then measure for each config
+   * mean cost per case of decoding of test case, transition, and encoding of
+   * post-state.
+   */
+  template <typename Vectors, typename TestCase>
+  int replay(int argc, char **argv, auto &&transition) {
+    size_t runs = 100;
+    if (argc > 1) {
+      std::string_view arg{argv[1]};
+      auto [_, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), runs);
+      if (ec != std::errc{} or runs == 0) {
+        fmt::println(stderr, "usage: {} [runs]", argv[0]);
+        return EXIT_FAILURE;
+      }
+    }
+    const auto warmup = runs / 10 + 1;
+
+    for (auto &vectors : Vectors::vectors()) {
+      if (vectors->paths.empty()) {
+        continue;
+      }
+      const auto &config = vectors->config;
+      auto label =
+          std::filesystem::relative(vectors->paths.begin()->parent_path(), dir)
+              .string();
+
+      std::vector<qtils::ByteVec> raw_cases;
+      std::vector<TestCase> cases;
+      for (auto &path : vectors->paths) {
+        auto raw = qtils::readBytes(path);
+        if (not raw) {
+          fmt::println(stderr, "can't read {}", path.native());
+          return EXIT_FAILURE;
+        }
+        auto testcase = decode_with_config<TestCase>(raw.value(), config);
+        if (not testcase) {
+          fmt::println(stderr, "can't decode {}", path.native());
+          return EXIT_FAILURE;
+        }
+        raw_cases.emplace_back(std::move(raw.value()));
+        cases.emplace_back(std::move(testcase.value()));
+      }
+      fmt::println("{}: {} cases, {} runs", label, cases.size(), runs);
+
+      const auto n = cases.size();
+      size_t i = 0;
+      benchmark(fmt::format("{} decode", label), warmup * n, runs * n, [&] {
+        auto testcase =
+            decode_with_config<TestCase>(raw_cases[i++ % n], config);
+        doNotOptimize(testcase);
+      });
+      i = 0;
+      benchmark(fmt::format("{} transition", label), warmup * n, runs * n, [&] {
+        auto &testcase = cases[i++ % n];
+        auto result = transition(config, testcase.pre_state, testcase.input);
+        doNotOptimize(result);
+      });
+      if constexpr (std::is_invocable_v<decltype(transition),
+                                        decltype(config),
+                                        decltype(cases[0].pre_state) &,
+                                        decltype(cases[0].input) &,
+                                        std::pmr::memory_resource *>) {
+        std::pmr::monotonic_buffer_resource arena;
+        i = 0;
+        benchmark(fmt::format("{} transition (arena)", label),
+                  warmup * n,
+                  runs * n,
+                  [&] {
+                    auto &testcase = cases[i++ % n];
+                    auto result = transition(
+                        config, testcase.pre_state, testcase.input, &arena);
+                    doNotOptimize(result);
+                    arena.release();
+                  });
+      }
+      i = 0;
+      benchmark(fmt::format("{} encode", label), warmup * n, runs * n, [&] {
+        auto encoded = encode_with_config(cases[i++ % n].post_state, config);
+        doNotOptimize(encoded);
+      });
+    }
+    return EXIT_SUCCESS;
+  }
+}  // namespace jam::test_vectors
@@ -0,0 +1,247 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <system_error>
+#include <vector>
+
+#include <scale/jam_scale.hpp>
+
+namespace jam {
+  /**
+   * Fixed-capacity ring buffer with inline storage.
+   * Used for bounded sequences of state (e.g. authorizer pools), which are
+   * modified by popping from the front and pushing to the back, to avoid
+   * per-item allocations.
+   * Encoded the same way as `std::vector<T>`.
+   */
+  template <typename T, size_t N>
+  class RingBuffer {
+    static_assert(N != 0);
+
+    template <bool Const>
+    class Iterator {
+      using Buffer = std::conditional_t<Const, const RingBuffer, RingBuffer>;
+
+     public:
+      using iterator_category = std::bidirectional_iterator_tag;
+      using value_type = T;
+      using difference_type = std::ptrdiff_t;
+      using pointer = std::conditional_t<Const, const T *, T *>;
+      using reference = std::conditional_t<Const, const T &, T &>;
+
+      Iterator() = default;
+      Iterator(Buffer *buffer, size_t index) : buffer_{buffer}, index_{index} {}
+      operator Iterator<true>() const {
+        return {buffer_, index_};
+      }
+
+      reference operator*() const {
+        return (*buffer_)[index_];
+      }
+      pointer operator->() const {
+        return &(*buffer_)[index_];
+      }
+      Iterator &operator++() {
+        ++index_;
+        return *this;
+      }
+      Iterator operator++(int) {
+        auto it = *this;
+        ++index_;
+        return it;
+      }
+      Iterator &operator--() {
+        --index_;
+        return *this;
+      }
+      Iterator operator--(int) {
+        auto it = *this;
+        --index_;
+        return it;
+      }
+      bool operator==(const Iterator &other) const {
+        return index_ == other.index_;
+      }
+      difference_type operator-(const Iterator &other) const {
+        return static_cast<difference_type>(index_)
+             - static_cast<difference_type>(other.index_);
+      }
+
+     private:
+      Buffer *buffer_ = nullptr;
+      size_t index_ = 0;
+    };
+
+   public:
+    using value_type = T;
+    using size_type = size_t;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    RingBuffer() = default;
+
+    RingBuffer(std::initializer_list<T> items) {
+      assert(items.size() <= N);
+      for (auto &item : items) {
+        push_back(item);
+      }
+    }
+
+    static constexpr size_t capacity() {
+      return N;
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    bool full() const {
+      return size_ == N;
+    }
+
+    T &operator[](size_t i) {
+      assert(i < size_);
+      return items_[(head_ + i) % N];
+    }
+
+    const T &operator[](size_t i) const {
+      assert(i < size_);
+      return items_[(head_ + i) % N];
+    }
+
+    T &front() {
+      return (*this)[0];
+    }
+
+    const T &front() const {
+      return (*this)[0];
+    }
+
+    T &back() {
+      return (*this)[size_ - 1];
+    }
+
+    const T &back() const {
+      return (*this)[size_ - 1];
+    }
+
+    iterator begin() {
+      return {this, 0};
+    }
+
+    iterator end() {
+      return {this, size_};
+    }
+
+    const_iterator begin() const {
+      return {this, 0};
+    }
+
+    const_iterator end() const {
+      return {this, size_};
+    }
+
+    /// Append item, buffer must not be full
+    template <typename... A>
+    T &emplace_back(A &&...args) {
+      assert(not full());
+      auto &slot = items_[(head_ + size_) % N];
+      slot = T(std::forward<A>(args)...);
+      ++size_;
+      return slot;
+    }
+
+    void push_back(const T &item) {
+      emplace_back(item);
+    }
+
+    void push_back(T &&item) {
+      emplace_back(std::move(item));
+    }
+
+    /// Remove first item, buffer must not be empty
+    void pop_front() {
+      assert(not empty());
+      items_[head_] = T{};
+      head_ = (head_ + 1) % N;
+      --size_;
+    }
+
+    void clear() {
+      while (not empty()) {
+        pop_front();
+      }
+      head_ = 0;
+    }
+
+    /// Remove all items equal to `value`, preserving order of the rest.
+    /// Returns number of removed items, as `std::erase` does.
+    friend size_t erase(RingBuffer &v, const T &value) {
+      size_t kept = 0;
+      for (size_t i = 0; i < v.size_; ++i) {
+        if (v[i] == value) {
+          continue;
+        }
+        if (kept != i) {
+          v[kept] = std::move(v[i]);
+        }
+        ++kept;
+      }
+      auto removed = v.size_ - kept;
+      for (size_t i = kept; i < v.size_; ++i) {
+        v[i] = T{};
+      }
+      v.size_ = kept;
+      return removed;
+    }
+
+    bool operator==(const RingBuffer &other) const {
+      if (size_ != other.size_) {
+        return false;
+      }
+      for (size_t i = 0; i < size_; ++i) {
+        if (not((*this)[i] == other[i])) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    // Encoding is not on the hot path, so an intermediate vector is used to
+    // keep the exact `std::vector<T>` format
+    friend void encode(const RingBuffer &v, scale::Encoder &encoder) {
+      encode(std::vector<T>(v.begin(), v.end()), encoder);
+    }
+
+    friend void decode(RingBuffer &v, scale::Decoder &decoder) {
+      std::vector<T> items;
+      decode(items, decoder);
+      if (items.size() > N) {
+        throw std::system_error{
+            std::make_error_code(std::errc::value_too_large)};
+      }
+      v.clear();
+      for (auto &item : items) {
+        v.push_back(std::move(item));
+      }
+    }
+
+   private:
+    std::array<T, N> items_{};
+    size_t head_ = 0;
+    size_t size_ = 0;
+  };
+}  // namespace jam
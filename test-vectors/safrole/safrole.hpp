@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include <memory_resource>
 #include <set>
+#include <span>
 #include <unordered_map>
+#include <vector>
 
 #include <crypto/bandersnatch.hpp>
 #include <qtils/cxx23/ranges/contains.hpp>
@@ -15,6 +18,7 @@
 #include <jam_types/common-types.hpp>
 #include <test-vectors/common.hpp>
 #include <jam_types/config-full.hpp>
+#include <utils/flat_hash_map.hpp>
 
 namespace jam::safrole {
   namespace types = jam::test_vectors;
@@ -65,8 +69,20 @@ namespace jam::safrole {
   inline BandersnatchKeys bandersnatch_keys(
       const types::ValidatorsData &validators) {
     BandersnatchKeys keys;
-    keys.reserve(validators.size());
-    for (auto &validator : validators) {
+    keys.reserve(validators->size());
+    for (auto &validator : *validators) {
+      keys.emplace_back(validator.bandersnatch);
+    }
+    return keys;
+  }
+
+  /// Bandersnatch keys of validators, allocated from `arena`.
+  inline std::pmr::vector<crypto::bandersnatch::Public> bandersnatch_keys(
+      const types::ValidatorsData &validators,
+      std::pmr::memory_resource *arena) {
+    std::pmr::vector<crypto::bandersnatch::Public> keys{arena};
+    keys.reserve(validators->size());
+    for (auto &validator : *validators) {
       keys.emplace_back(validator.bandersnatch);
     }
     return keys;
@@ -75,7 +91,7 @@ namespace jam::safrole {
   // [GP 0.4.5 G 340]
   // https://github.com/gavofyork/graypaper/blob/v0.4.5/text/bandersnatch.tex#L15
   inline GammaZ mathcal_O(const types::Config &config,
-                          const BandersnatchKeys &pks) {
+                          std::span<const crypto::bandersnatch::Public> pks) {
     return ring_ctx(config).commitment(pks).value();
   }
 
@@ -98,11 +114,13 @@ namespace jam::safrole {
 
   /**
    * Given state and input, derive next state and output.
+   * Temporary containers are allocated from `arena`.
    */
   inline std::pair<types::safrole::State, types::safrole::Output> transition(
       const types::Config &config,
       const types::safrole::State &state,
-      const types::safrole::Input &input) {
+      const types::safrole::Input &input,
+      std::pmr::memory_resource *arena = std::pmr::get_default_resource()) {
     /// The length of an epoch in timeslots.
     // [GP 0.4.5 I.4.4]
     // https://github.com/gavofyork/graypaper/blob/v0.4.5/text/definitions.tex#L260
@@ -199,14 +217,16 @@ namespace jam::safrole {
     // [GP 0.4.5 6.3 59]
     // https://github.com/gavofyork/graypaper/blob/v0.4.5/text/safrole.tex#L101
     const auto phi = [&](const types::ValidatorsData &k) {
-      types::ValidatorsData k_tick;
-      for (auto &validator : k) {
+      const pmr::FlatHashSet<types::Ed25519Public> offenders{
+          post_offenders.begin(), post_offenders.end(), arena};
+      types::ValidatorsData::Value k_tick;
+      for (auto &validator : *k) {
         k_tick.emplace_back(
-            qtils::cxx23::ranges::contains(post_offenders, validator.ed25519)
+            offenders.contains(validator.ed25519)
                 ? types::ValidatorData{}
                 : validator);
       }
-      return k_tick;
+      return types::ValidatorsData{std::move(k_tick), config};
     };
     // [GP 0.4.5 6.3 58]
     // https://github.com/gavofyork/graypaper/blob/v0.4.5/text/safrole.tex#L97
@@ -216,7 +236,7 @@ namespace jam::safrole {
               gamma_tick_k,
               gamma_k,
               kappa,
-              mathcal_O(config, bandersnatch_keys(gamma_tick_k)),
+              mathcal_O(config, bandersnatch_keys(gamma_tick_k, arena)),
           };
         }(phi(iota))
                      : std::tuple{gamma_k, kappa, lambda, gamma_z};
@@ -241,7 +261,7 @@ namespace jam::safrole {
     // merging new tickets into the previous accumulator value
     // (or the empty sequence if it is a new epoch)
     // [GP 0.5.2 6.7 (6.34)]
-    std::set<types::TicketBody, TicketBodyLess> gamma_tick_a;
+    std::pmr::set<types::TicketBody, TicketBodyLess> gamma_tick_a{arena};
     if (not change_epoch) {
       gamma_tick_a.insert(gamma_a.begin(), gamma_a.end());
     }
@@ -329,7 +349,7 @@ namespace jam::safrole {
       for (uint32_t i = 0; i < E; ++i) {
         keys.emplace_back(
             circlearrowleft(
-                k, de(first_bytes<4>(mathcal_H(frown(r, mathcal_E<4>(i))))))
+                *k, de(first_bytes<4>(mathcal_H(frown(r, mathcal_E<4>(i))))))
                 .bandersnatch);
       }
       return keys;
@@ -0,0 +1,12 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <jam_types/safrole-types.hpp>
+#include <test-vectors/safrole/safrole.hpp>
+#include <test-vectors/safrole/vectors.hpp>
+#include <test-vectors/replay.hpp>
+
+BENCHMARK_VECTORS_REPLAY(safrole)
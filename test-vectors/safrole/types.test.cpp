@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <jam_types/safrole-types-full.hpp>
+#include <jam_types/safrole-types-tiny.hpp>
 #include <test-vectors/safrole/vectors.hpp>
 
 GTEST_VECTORS(Safrole, safrole);
@@ -12,3 +14,8 @@ GTEST_VECTORS(Safrole, safrole);
  * Check python generated scale encoding/decoding against test vectors.
  */
 GTEST_VECTORS_TEST_REENCODE(Safrole, safrole);
+
+/**
+ * Check types specialized for constant sets against test vectors.
+ */
+GTEST_VECTORS_TEST_REENCODE_SPECIALIZED(Safrole, safrole);
@@ -0,0 +1,181 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <se/impl/dispatcher.hpp>
+
+namespace jam {
+  /**
+   * Time spent by stage of `StageGraph`.
+   */
+  struct StageTiming {
+    std::string name;
+    /// Since start of graph run
+    std::chrono::nanoseconds begin{};
+    /// Duration of stage itself
+    std::chrono::nanoseconds duration{};
+  };
+
+  /**
+   * Per-stage time breakdown of `StageGraph` run.
+   */
+  struct StageReport {
+    std::vector<StageTiming> stages;
+    /// Wall time of whole run
+    std::chrono::nanoseconds total{};
+  };
+
+  /**
+   * Directed acyclic graph of stages with declared data dependencies.
+   * Stage is started when all stages it depends on are finished, so
+   * independent stages run concurrently on dispatcher pool.
+   * Calling thread takes part in execution and returns when all stages are
+   * finished.
+   */
+  class StageGraph {
+   public:
+    using Id = size_t;
+    using Task = std::function<void()>;
+
+    /// Add stage, which depends on previously added stages `deps`
+    Id add(std::string name, std::vector<Id> deps, Task task) {
+      const auto id = stages_.size();
+      for (auto dep : deps) {
+        assert(dep < id);
+        stages_[dep].dependents.emplace_back(id);
+      }
+      stages_.emplace_back(Stage{
+          .name = std::move(name),
+          .deps = deps.size(),
+          .task = std::move(task),
+      });
+      return id;
+    }
+
+    /**
+     * Run all stages, ready ones are posted to dispatcher pool.
+     * Without dispatcher stages are run one by one in order of adding.
+     * First exception thrown by stage is rethrown after all started stages
+     * are finished; stages which are not started yet are skipped.
+     * Dispatcher must not be disposed during run.
+     */
+    StageReport run(se::Dispatcher *dispatcher) {
+      // Shared with posted tasks, which may still hold it when run is over
+      auto run = std::make_shared<Run>(*this, dispatcher);
+      if (dispatcher == nullptr) {
+        for (Id id = 0; id < stages_.size(); ++id) {
+          run->execute(id, false);
+        }
+      } else {
+        std::vector<Id> ready;
+        for (Id id = 0; id < stages_.size(); ++id) {
+          if (stages_[id].deps == 0) {
+            ready.emplace_back(id);
+          }
+        }
+        run->start(ready);
+        run->done.wait();
+      }
+      run->report.total = Clock::now() - run->begin;
+      if (run->error) {
+        std::rethrow_exception(run->error);
+      }
+      return std::move(run->report);
+    }
+
+   private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stage {
+      std::string name;
+      size_t deps;
+      Task task;
+      std::vector<Id> dependents{};
+    };
+
+    struct Run : std::enable_shared_from_this<Run> {
+      Run(const StageGraph &graph, se::Dispatcher *dispatcher)
+          : graph{graph},
+            dispatcher{dispatcher},
+            remaining(graph.stages_.size()),
+            done{static_cast<std::ptrdiff_t>(graph.stages_.size())} {
+        for (Id id = 0; id < graph.stages_.size(); ++id) {
+          remaining[id] = graph.stages_[id].deps;
+          report.stages.emplace_back(
+              StageTiming{.name = graph.stages_[id].name});
+        }
+      }
+
+      /// Post all but last ready stage to pool, run last one in place
+      void start(const std::vector<Id> &ready) {
+        if (ready.empty()) {
+          return;
+        }
+        for (size_t i = 0; i + 1 < ready.size(); ++i) {
+          dispatcher->add(se::Dispatcher::kExecuteInPool,
+                          [self{shared_from_this()}, id{ready[i]}] {
+                            self->execute(id, true);
+                          });
+        }
+        execute(ready.back(), true);
+      }
+
+      void execute(Id id, bool chain) {
+        auto &stage = graph.stages_[id];
+        auto &timing = report.stages[id];
+        if (not failed.load()) {
+          const auto stage_begin = Clock::now();
+          try {
+            stage.task();
+          } catch (...) {
+            std::lock_guard lock{error_mutex};
+            if (not error) {
+              error = std::current_exception();
+            }
+            failed.store(true);
+          }
+          timing.begin = stage_begin - begin;
+          timing.duration = Clock::now() - stage_begin;
+        }
+        std::vector<Id> ready;
+        for (auto dependent : stage.dependents) {
+          if (remaining[dependent].fetch_sub(1) == 1) {
+            ready.emplace_back(dependent);
+          }
+        }
+        if (chain) {
+          start(ready);
+        }
+        // Last access to graph, waiter may return as soon as count reaches 0
+        done.count_down();
+      }
+
+      const StageGraph &graph;
+      se::Dispatcher *dispatcher;
+      const Clock::time_point begin = Clock::now();
+      std::vector<std::atomic_size_t> remaining;
+      std::latch done;
+      std::atomic_bool failed = false;
+      std::mutex error_mutex;
+      std::exception_ptr error;
+      StageReport report;
+    };
+
+    std::vector<Stage> stages_;
+  };
+}  // namespace jam
@@ -0,0 +1,125 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <qtils/byte_vec.hpp>
+
+#include <crypto/blake.hpp>
+#include <jam_types/config.hpp>
+#include <scale/jam_scale.hpp>
+
+namespace jam {
+  /**
+   * Value with modification flag, and its encoding and blake2b hash as of
+   * last `flush`.
+   * Used for state components, most of which are not modified by block, so
+   * only modified ones are re-encoded and rewritten to storage.
+   * Newly constructed or decoded value is considered modified.
+   */
+  template <typename T>
+  class Tracked {
+   public:
+    using Hash = crypto::Blake::Hash;
+
+    Tracked() = default;
+
+    explicit Tracked(T value) : value_{std::move(value)} {}
+
+    const T &value() const {
+      return value_;
+    }
+
+    const T &operator*() const {
+      return value_;
+    }
+
+    const T *operator->() const {
+      return &value_;
+    }
+
+    /// Mutable access, marks value as modified
+    T &mutate() {
+      dirty_ = true;
+      return value_;
+    }
+
+    /// Replace value, marks it as modified only if it differs.
+    /// Value is copied only then. Returns whether it was modified.
+    bool set(const T &value) {
+      return modify([&](T &current) { return assign(current, value); });
+    }
+
+    /// Modify value in place by `f(value)`, which returns whether it changed
+    /// anything, e.g. to update some fields of aggregate component without
+    /// building whole new value. Marks value as modified only if it changed.
+    template <typename F>
+    bool modify(F &&f) {
+      if (not f(value_)) {
+        return false;
+      }
+      dirty_ = true;
+      return true;
+    }
+
+    /// Copy `from` to `to` if they differ. Returns whether they differed.
+    template <typename U>
+    static bool assign(U &to, const U &from) {
+      if (to == from) {
+        return false;
+      }
+      to = from;
+      return true;
+    }
+
+    bool dirty() const {
+      return dirty_;
+    }
+
+    /// Re-encode and re-hash value if modified since last flush.
+    /// Returns whether it was modified.
+    bool flush(const test_vectors::Config &config) {
+      if (not dirty_) {
+        return false;
+      }
+      // Buffer capacity is reused between blocks
+      encoded_.clear();
+      encode_append(encoded_, value_, config).value();
+      hash_ = crypto::Blake::hash(encoded_);
+      dirty_ = false;
+      return true;
+    }
+
+    /// Encoding as of last flush
+    const qtils::ByteVec &encoded() const {
+      return encoded_;
+    }
+
+    /// Hash of encoding as of last flush
+    const Hash &hash() const {
+      return hash_;
+    }
+
+    bool operator==(const Tracked &other) const {
+      return value_ == other.value_;
+    }
+
+    friend void encode(const Tracked &v, scale::Encoder &encoder) {
+      encode(v.value_, encoder);
+    }
+
+    friend void decode(Tracked &v, scale::Decoder &decoder) {
+      decode(v.value_, decoder);
+      v.dirty_ = true;
+    }
+
+   private:
+    T value_{};
+    bool dirty_ = true;
+    qtils::ByteVec encoded_;
+    Hash hash_{};
+  };
+}  // namespace jam
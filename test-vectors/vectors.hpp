@@ -9,6 +9,7 @@
 #include <gtest/gtest.h>
 
 #include <filesystem>
+#include <memory>
 #include <set>
 
 #include <fmt/format.h>
@@ -100,6 +101,38 @@
     EXPECT_EQ(reencoded, original);                                     \
   }
 
+/**
+ * Check types specialized for constant set against test vectors.
+ * @given `original` value
+ * @when decode it as types of constant set of vectors and encode back
+ * @then `actual` result has the same value as `original`
+ */
+#define GTEST_VECTORS_TEST_REENCODE_SPECIALIZED(VectorName, NsPart)          \
+  TEST_P(VectorName##Test, ReencodeSpecialized) {                            \
+    using jam::test_vectors::getTestLabel;                                   \
+    fmt::println("Test specialized reencode for '{}'\n", getTestLabel(path)); \
+                                                                             \
+    ASSERT_OUTCOME_SUCCESS(raw_data, qtils::readBytes(path));                \
+    const auto &original = raw_data;                                         \
+                                                                             \
+    /* Full config types are several MiB, so they are kept on heap */        \
+    auto reencode = [&]<typename TestCase>() {                               \
+      auto decoded = std::make_unique<TestCase>();                           \
+      ASSERT_OUTCOME_SUCCESS(                                                \
+          (jam::decode_into(*decoded, original, vectors.config)));           \
+      ASSERT_OUTCOME_SUCCESS(                                                \
+          reencoded, (jam::encode_with_config(*decoded, vectors.config)));   \
+      EXPECT_EQ(reencoded, original);                                        \
+    };                                                                       \
+    if (vectors.type == "full") {                                            \
+      reencode.template operator()<                                          \
+          jam::test_vectors::full::NsPart::TestCase>();                      \
+    } else {                                                                 \
+      reencode.template operator()<                                          \
+          jam::test_vectors::tiny::NsPart::TestCase>();                      \
+    }                                                                        \
+  }
+
 namespace jam::test_vectors {
   inline const std::filesystem::path dir =
       std::filesystem::path{PROJECT_SOURCE_DIR} / "test-vectors/jamtestvectors";
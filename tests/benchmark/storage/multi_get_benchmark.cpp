@@ -0,0 +1,103 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+#include <qtils/byte_vec.hpp>
+
+#include <app/configuration.hpp>
+#include <storage/in_memory/in_memory_storage.hpp>
+#include <storage/rocksdb/rocksdb.hpp>
+#include <test-vectors/benchmark.hpp>
+#include <testutil/prepare_loggers.hpp>
+
+/**
+ * Reading batch of 1024 random keys from `storage::BufferStorage` with
+ * `tryGet` per key against one `multiGet`, for `InMemoryStorage` and for
+ * RocksDB space (in temporary directory, with flushed and compacted data).
+ * Half of keys are absent.
+ */
+
+using jam::storage::BufferStorage;
+using jam::storage::ByteVec;
+using jam::storage::ByteView;
+
+struct Configuration : jam::app::Configuration {
+  const DatabaseConfig &database() const override {
+    return database_config;
+  }
+
+  DatabaseConfig database_config;
+};
+
+int main(int argc, char **argv) {
+  using jam::test_vectors::benchmark;
+  using jam::test_vectors::doNotOptimize;
+
+  constexpr size_t kEntries = 1 << 18;
+  constexpr size_t kBatch = 1024;
+  const size_t runs = argc > 1 ? std::stoul(argv[1]) : 100;
+
+  std::mt19937_64 random{0};
+  auto random_bytes = [&](size_t size) {
+    ByteVec bytes(size);
+    for (auto &byte : bytes) {
+      byte = static_cast<uint8_t>(random());
+    }
+    return bytes;
+  };
+
+  auto config = std::make_shared<Configuration>();
+  config->database_config.directory =
+      std::filesystem::temp_directory_path() / "jam_multi_get_benchmark";
+  std::filesystem::remove_all(config->database_config.directory);
+  auto rocks = std::make_shared<jam::storage::RocksDb>(
+      testutil::prepareLoggers(soralog::Level::WARN), config);
+  auto rocks_space = rocks->getSpace(jam::storage::Space::Default);
+  auto memory = std::make_shared<jam::storage::InMemoryStorage>();
+
+  std::vector<ByteVec> keys;
+  for (size_t i = 0; i < kEntries; ++i) {
+    keys.emplace_back(random_bytes(32));
+    auto value = random_bytes(128);
+    rocks_space->put(keys.back(), ByteView{value}).value();
+    memory->put(keys.back(), ByteView{value}).value();
+  }
+  std::dynamic_pointer_cast<jam::storage::RocksDbSpace>(rocks_space)
+      ->compact({}, {});
+
+  std::vector<ByteVec> batch_keys;
+  for (size_t i = 0; i < kBatch; ++i) {
+    batch_keys.emplace_back(i % 2 == 0 ? keys[random() % kEntries]
+                                       : random_bytes(32));
+  }
+  std::vector<ByteView> batch(batch_keys.begin(), batch_keys.end());
+
+  for (auto [name, storage] :
+       {std::pair<const char *, BufferStorage *>{"InMemoryStorage",
+                                                 memory.get()},
+        {"RocksDbSpace", rocks_space.get()}}) {
+    benchmark(fmt::format("{} tryGet x{}", name, kBatch), 1, runs, [&] {
+      size_t found = 0;
+      for (auto &key : batch) {
+        found += storage->tryGet(key).value().has_value();
+      }
+      doNotOptimize(found);
+    });
+    benchmark(fmt::format("{} multiGet x{}", name, kBatch), 1, runs, [&] {
+      doNotOptimize(storage->multiGet(batch).value());
+    });
+  }
+
+  rocks_space.reset();
+  rocks.reset();
+  std::filesystem::remove_all(config->database_config.directory);
+  return EXIT_SUCCESS;
+}
@@ -12,6 +12,7 @@ namespace test {
     rocksdb::Options options;
     options.create_if_missing = true;
 
+    db_.reset();
     rocks_.reset();
     ASSERT_NO_THROW(
         rocks_ = std::make_shared<jam::storage::RocksDb>(logsys, app_config));
@@ -27,7 +28,7 @@ namespace test {
     logsys = testutil::prepareLoggers();
     app_config = std::make_shared<jam::app::ConfigurationMock>();
 
-    jam::app::Configuration::DatabaseConfig db_config{
+    db_config = {
         .directory = getPathString() + "/db",
         .cache_size = 8 << 20,  // 8Mb
     };
@@ -19,6 +19,7 @@ namespace test {
 
     BaseRocksDB_Test(fs::path path);
 
+    /// (Re)open database with `db_config`
     void open();
 
     void SetUp() override;
@@ -27,6 +28,8 @@ namespace test {
 
     std::shared_ptr<jam::log::LoggingSystem> logsys;
     std::shared_ptr<jam::app::ConfigurationMock> app_config;
+    /// Returned by `app_config`, may be changed before `open`
+    jam::app::Configuration::DatabaseConfig db_config;
 
     std::shared_ptr<RocksDB> rocks_;
     std::shared_ptr<jam::storage::BufferStorage> db_;
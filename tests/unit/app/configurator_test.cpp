@@ -0,0 +1,126 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <fstream>
+
+#include "app/configuration.hpp"
+#include "app/configurator.hpp"
+#include "testutil/storage/base_fs_test.hpp"
+
+using jam::app::Configuration;
+using jam::app::Configurator;
+
+struct ConfiguratorTest : public test::BaseFS_Test {
+  ConfiguratorTest() : test::BaseFS_Test("/tmp/jam_configurator_test") {}
+
+  void SetUp() override {
+    BaseFS_Test::SetUp();
+    fs::create_directory(base_path / "modules");
+    std::ofstream{base_path / "spec.json"} << "{}";
+  }
+
+  /// Calculate config from file with given `database` section
+  outcome::result<std::shared_ptr<Configuration>> parse(
+      const std::string &database) {
+    const auto path = (base_path / "config.yaml").string();
+    std::ofstream{path} << "general:\n"
+                        << "  base_path: " << getPathString() << "\n"
+                        << "  modules_dir: modules\n"
+                        << "  spec_file: spec.json\n"
+                        << "database:\n"
+                        << database;
+    std::array<const char *, 4> argv{
+        "jam_node", "--config", path.c_str(), nullptr};
+    std::array<const char *, 1> env{nullptr};
+    Configurator configurator(3, argv.data(), env.data());
+    OUTCOME_TRY(configurator.step1());
+    OUTCOME_TRY(configurator.step2());
+    return configurator.calculateConfig(logger);
+  }
+};
+
+/**
+ * @given database section with per-space options
+ * @when config is calculated
+ * @then options are read by name of space
+ */
+TEST_F(ConfiguratorTest, DatabaseSpaceOptions) {
+  auto config = parse(
+      "  cache_size: 67108864\n"
+      "  column_cache_size:\n"
+      "    default: 0.25\n"
+      "    other: 0.5\n"
+      "  column_ttl:\n"
+      "    default: 90000\n"
+      "  cached_columns:\n"
+      "    default: 1048576\n"
+      "  column_prefix_length:\n"
+      "    default: 4\n"
+      "  wal_sync_interval: 100\n");
+  ASSERT_TRUE(config.has_value()) << config.error();
+  const auto &database = config.value()->database();
+  EXPECT_EQ(database.cache_size, 64 << 20);
+  EXPECT_EQ(database.column_cache_size,
+            (std::unordered_map<std::string, double>{{"default", 0.25},
+                                                     {"other", 0.5}}));
+  EXPECT_EQ(database.column_ttl,
+            (std::unordered_map<std::string, int32_t>{{"default", 90000}}));
+  EXPECT_EQ(database.cached_columns,
+            (std::unordered_map<std::string, size_t>{{"default", 1 << 20}}));
+  EXPECT_EQ(database.column_prefix_length,
+            (std::unordered_map<std::string, size_t>{{"default", 4}}));
+  EXPECT_EQ(database.wal_sync_interval, std::chrono::milliseconds{100});
+}
+
+/**
+ * @given database section without per-space options
+ * @when config is calculated
+ * @then there are no per-space options
+ */
+TEST_F(ConfiguratorTest, DatabaseDefaults) {
+  auto config = parse("  cache_size: 1073741824\n");
+  ASSERT_TRUE(config.has_value()) << config.error();
+  const auto &database = config.value()->database();
+  EXPECT_EQ(database.cache_size, 1 << 30);
+  EXPECT_TRUE(database.column_cache_size.empty());
+  EXPECT_TRUE(database.column_ttl.empty());
+  EXPECT_TRUE(database.cached_columns.empty());
+  EXPECT_TRUE(database.column_prefix_length.empty());
+  EXPECT_EQ(database.wal_sync_interval, std::chrono::milliseconds{0});
+}
+
+/**
+ * @given database sections with invalid per-space options
+ * @when config is calculated
+ * @then config file is rejected
+ */
+TEST_F(ConfiguratorTest, DatabaseInvalidSpaceOptions) {
+  for (auto database : {
+           // share out of range
+           "  column_cache_size:\n    default: 1.5\n",
+           // shares sum to more than whole cache
+           "  column_cache_size:\n    default: 0.6\n    other: 0.6\n",
+           // not a map
+           "  column_cache_size: 0.5\n",
+           // negative ttl
+           "  column_ttl:\n    default: -1\n",
+           // bad byte quantity
+           "  cached_columns:\n    default: lots\n",
+           // zero prefix length
+           "  column_prefix_length:\n    default: 0\n",
+           // not a number
+           "  wal_sync_interval: soon\n",
+       }) {
+    auto config = parse(database);
+    EXPECT_FALSE(config.has_value()) << database;
+    if (not config.has_value()) {
+      EXPECT_EQ(config.error(), Configurator::Error::ConfigFileParseFailed);
+    }
+  }
+}
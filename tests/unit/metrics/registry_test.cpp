@@ -0,0 +1,72 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "metrics/impl/prometheus/registry_impl.hpp"
+#include "metrics/metrics.hpp"
+
+using jam::metrics::Collector;
+using jam::metrics::Gauge;
+using jam::metrics::PrometheusRegistry;
+
+/// Sets gauge to number of collections
+struct CountingCollector : Collector {
+  explicit CountingCollector(Gauge *gauge) : gauge{gauge} {}
+
+  void collect() override {
+    ++count;
+    gauge->set(count);
+  }
+
+  Gauge *gauge;
+  int count = 0;
+};
+
+/**
+ * @given collector registered in registry
+ * @when collectors are run, before and after collector is destroyed
+ * @then alive collector updates its metrics, destroyed one is skipped
+ */
+TEST(RegistryTest, RunCollectors) {
+  auto registry = jam::metrics::createRegistry();
+  registry->registerGaugeFamily("test_collections", "Number of collections");
+  auto gauge = registry->registerGaugeMetric("test_collections");
+
+  auto collector = std::make_shared<CountingCollector>(gauge);
+  registry->registerCollector(collector);
+  PrometheusRegistry::runCollectors();
+  PrometheusRegistry::runCollectors();
+  EXPECT_EQ(collector->count, 2);
+  EXPECT_EQ(PrometheusRegistry::internalMetric(gauge)->Value(), 2);
+
+  collector.reset();
+  PrometheusRegistry::runCollectors();
+  EXPECT_EQ(PrometheusRegistry::internalMetric(gauge)->Value(), 2);
+}
+
+/**
+ * @given collectors registered through different registries
+ * @when collectors are run
+ * @then each one is run once, since collectors are shared like metrics
+ */
+TEST(RegistryTest, CollectorsSharedByRegistries) {
+  auto registry1 = jam::metrics::createRegistry();
+  auto registry2 = jam::metrics::createRegistry();
+  registry1->registerGaugeFamily("test_shared_collections");
+  auto gauge1 = registry1->registerGaugeMetric("test_shared_collections",
+                                               {{"registry", "1"}});
+  auto gauge2 = registry1->registerGaugeMetric("test_shared_collections",
+                                               {{"registry", "2"}});
+
+  auto collector1 = std::make_shared<CountingCollector>(gauge1);
+  auto collector2 = std::make_shared<CountingCollector>(gauge2);
+  registry1->registerCollector(collector1);
+  registry2->registerCollector(collector2);
+  PrometheusRegistry::runCollectors();
+  EXPECT_EQ(collector1->count, 1);
+  EXPECT_EQ(collector2->count, 1);
+}
@@ -0,0 +1,54 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <qtils/test/outcome.hpp>
+
+#include <test-vectors/byte-view.hpp>
+
+using jam::ByteArrView;
+
+/**
+ * Struct with fixed-size byte field between other fields, decoded as nested
+ * one.
+ */
+struct Record {
+  uint8_t tag = 0;
+  ByteArrView<4> hash;
+  uint32_t index = 0;
+
+  friend void decode(Record &v, scale::Decoder &decoder) {
+    decode(v.tag, decoder);
+    decode(v.hash, decoder);
+    decode(v.index, decoder);
+  }
+};
+
+/**
+ * @given bytes of struct with view field
+ * @when decode it borrowing input
+ * @then view points into input, and other fields are copied
+ */
+TEST(ByteViewTest, PointsIntoInput) {
+  std::vector<uint8_t> input{7, 1, 2, 3, 4, 5, 0, 0, 0};
+  ASSERT_OUTCOME_SUCCESS(record, jam::decode_borrowed<Record>(input));
+  EXPECT_EQ(record.tag, 7);
+  EXPECT_EQ(record.hash.data(), input.data() + 1);
+  EXPECT_EQ(record.hash.toArr(), (qtils::ByteArr<4>{1, 2, 3, 4}));
+  EXPECT_EQ(record.index, 5);
+}
+
+/**
+ * @given bytes of struct, truncated within view field
+ * @when decode it borrowing input
+ * @then `result_out_of_range` error is returned
+ */
+TEST(ByteViewTest, TruncatedInput) {
+  std::vector<uint8_t> input{7, 1, 2, 3};
+  ASSERT_OUTCOME_ERROR(jam::decode_borrowed<Record>(input),
+                       std::errc::result_out_of_range);
+}
@@ -0,0 +1,147 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <vector>
+
+#include <qtils/test/outcome.hpp>
+
+#include "crypto/blake.hpp"
+#include "scale/jam_scale.hpp"
+
+using jam::crypto::Blake;
+
+/// Hash of value encoded without and with materializing bytes
+template <typename T>
+std::pair<Blake::Hash, Blake::Hash> hashes(const T &value) {
+  return {jam::hash_encoded<Blake>(value).value(),
+          Blake::hash(jam::encode_with_config(value).value())};
+}
+
+/**
+ * @given values, whose encodings fit into encoder buffer
+ * @when hash their encodings
+ * @then hash is same as hash of materialized encoding
+ */
+TEST(HashingEncoderTest, SmallValues) {
+  {
+    auto [streamed, materialized] = hashes(uint8_t{7});
+    EXPECT_EQ(streamed, materialized);
+  }
+  {
+    auto [streamed, materialized] = hashes(std::vector<uint32_t>{1, 2, 3});
+    EXPECT_EQ(streamed, materialized);
+  }
+  {
+    auto [streamed, materialized] = hashes(std::vector<uint8_t>{});
+    EXPECT_EQ(streamed, materialized);
+  }
+}
+
+/**
+ * @given value encoded by writes, which cross end of encoder buffer
+ * @when hash its encoding
+ * @then buffer is flushed in order, and hash is same as hash of materialized
+ * encoding
+ */
+TEST(HashingEncoderTest, WriteCrossingBuffer) {
+  std::vector<std::array<uint8_t, 100>> value(3);
+  for (size_t i = 0; i < value.size(); ++i) {
+    value[i].fill(static_cast<uint8_t>(i + 1));
+  }
+  auto [streamed, materialized] = hashes(value);
+  EXPECT_EQ(streamed, materialized);
+}
+
+/**
+ * @given value with byte sequence not smaller than encoder buffer
+ * @when hash its encoding
+ * @then sequence is passed to hasher directly after buffered prefix, and hash
+ * is same as hash of materialized encoding
+ */
+TEST(HashingEncoderTest, LargeWrite) {
+  for (size_t size : {128, 129, 1000}) {
+    std::vector<uint8_t> value(size);
+    for (size_t i = 0; i < size; ++i) {
+      value[i] = static_cast<uint8_t>(i);
+    }
+    auto [streamed, materialized] = hashes(value);
+    EXPECT_EQ(streamed, materialized) << size;
+  }
+}
+
+/**
+ * @given value
+ * @when count size of its encoding, and encode it into buffer of that size
+ * @then whole buffer is written with same bytes as materialized encoding
+ */
+TEST(SpanEncoderTest, ExactSize) {
+  std::vector<uint32_t> value{1, 2, 3};
+  auto expected = jam::encode_with_config(value).value();
+  ASSERT_OUTCOME_SUCCESS(size, jam::encoded_size(value));
+  EXPECT_EQ(size, expected.size());
+
+  std::vector<uint8_t> out(size);
+  ASSERT_OUTCOME_SUCCESS(written, jam::encode_into(out, value));
+  EXPECT_EQ(written, size);
+  EXPECT_EQ(out, expected);
+}
+
+/**
+ * @given buffer smaller than encoding of value
+ * @when encode value into it
+ * @then `no_buffer_space` error is returned
+ */
+TEST(SpanEncoderTest, BufferTooSmall) {
+  std::vector<uint32_t> value{1, 2, 3};
+  auto size = jam::encoded_size(value).value();
+  std::vector<uint8_t> out(size - 1);
+  ASSERT_OUTCOME_ERROR(jam::encode_into(out, value),
+                       std::errc::no_buffer_space);
+}
+
+/**
+ * @given vector with prefix
+ * @when append encoding of value to it
+ * @then prefix is kept and followed by encoding
+ */
+TEST(EncodeAppendTest, KeepsPrefix) {
+  std::vector<uint32_t> value{1, 2, 3};
+  auto encoded = jam::encode_with_config(value).value();
+  std::vector<uint8_t> out{0xAA, 0xBB};
+  ASSERT_OUTCOME_SUCCESS(jam::encode_append(out, value));
+  ASSERT_EQ(out.size(), 2 + encoded.size());
+  EXPECT_EQ(out[0], 0xAA);
+  EXPECT_EQ(out[1], 0xBB);
+  EXPECT_TRUE(std::equal(encoded.begin(), encoded.end(), out.begin() + 2));
+}
+
+/**
+ * Value, whose encoding is longer than its counted size, as if it changed
+ * between counting and writing.
+ */
+struct Growing {
+  friend void encode(const Growing &, scale::Encoder &encoder) {
+    encoder.put(1);
+    if (dynamic_cast<jam::CountingEncoder *>(&encoder) == nullptr) {
+      encoder.put(2);
+    }
+  }
+};
+
+/**
+ * @given vector with prefix, and value failing to encode into counted size
+ * @when append encoding of value to it
+ * @then error is returned, and vector is restored to prefix
+ */
+TEST(EncodeAppendTest, RestoresSizeOnFailure) {
+  std::vector<uint8_t> out{0xAA, 0xBB};
+  ASSERT_OUTCOME_ERROR(jam::encode_append(out, Growing{}),
+                       std::errc::no_buffer_space);
+  EXPECT_EQ(out, (std::vector<uint8_t>{0xAA, 0xBB}));
+}
@@ -0,0 +1,64 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include <qtils/test/outcome.hpp>
+
+#include "scale/record_stream.hpp"
+
+using jam::MappedFile;
+using jam::RecordStream;
+using Record = std::vector<uint8_t>;
+
+struct RecordStreamTest : testing::Test {
+  void SetUp() override {
+    std::ofstream file{path, std::ios::binary};
+    for (uint8_t i = 0; i < 100; ++i) {
+      records.emplace_back(i, i);
+      auto encoded = jam::encode_with_config(records.back()).value();
+      file.write(reinterpret_cast<const char *>(encoded.data()),
+                 static_cast<std::streamsize>(encoded.size()));
+    }
+  }
+
+  void TearDown() override {
+    std::filesystem::remove(path);
+  }
+
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "jam-test-record-stream.bin";
+  std::vector<Record> records;
+};
+
+/**
+ * @given file of concatenated encoded records
+ * @when stream records from mapped file
+ * @then records are decoded one by one, in order, until end of file
+ */
+TEST_F(RecordStreamTest, DecodesConcatenatedRecords) {
+  ASSERT_OUTCOME_SUCCESS(file, MappedFile::open(path));
+  RecordStream<Record> stream{std::move(file)};
+  for (auto &expected : records) {
+    ASSERT_FALSE(stream.done());
+    ASSERT_OUTCOME_SUCCESS(record, stream.next());
+    EXPECT_EQ(record, expected);
+  }
+  EXPECT_TRUE(stream.done());
+  EXPECT_FALSE(stream.next().has_value());
+}
+
+/**
+ * @given path of missing file
+ * @when map it
+ * @then error is returned
+ */
+TEST_F(RecordStreamTest, MissingFile) {
+  EXPECT_FALSE(MappedFile::open(path.string() + ".missing").has_value());
+}
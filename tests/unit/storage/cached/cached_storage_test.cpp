@@ -0,0 +1,389 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <qtils/test/outcome.hpp>
+
+#include "storage/cached/cached_storage.hpp"
+#include "storage/in_memory/in_memory_batch.hpp"
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/storage_error.hpp"
+#include "testutil/prepare_loggers.hpp"
+
+using namespace jam::storage;
+
+/**
+ * In-memory storage safe to read and write from several threads, as cached
+ * storage reads backend without holding its lock. Values are copied, so they
+ * do not point into storage. Cursors are not locked, cached storage steps
+ * them under its lock, which is also held while backend is written.
+ */
+class LockedStorage : public BufferStorage {
+ public:
+  outcome::result<ByteVecOrView> get(const ByteView &key) const override {
+    std::lock_guard lock{mutex_};
+    OUTCOME_TRY(value, storage_.get(key));
+    return std::move(value).intoByteVec();
+  }
+
+  outcome::result<std::optional<ByteVecOrView>> tryGet(
+      const ByteView &key) const override {
+    std::lock_guard lock{mutex_};
+    OUTCOME_TRY(value, storage_.tryGet(key));
+    if (not value) {
+      return std::nullopt;
+    }
+    return ByteVecOrView{std::move(*value).intoByteVec()};
+  }
+
+  outcome::result<bool> contains(const ByteView &key) const override {
+    std::lock_guard lock{mutex_};
+    return storage_.contains(key);
+  }
+
+  outcome::result<void> put(const ByteView &key,
+                            ByteVecOrView &&value) override {
+    std::lock_guard lock{mutex_};
+    return storage_.put(key, std::move(value));
+  }
+
+  outcome::result<void> remove(const ByteView &key) override {
+    std::lock_guard lock{mutex_};
+    return storage_.remove(key);
+  }
+
+  std::unique_ptr<BufferBatch> batch() override {
+    return std::make_unique<InMemoryBatch>(*this);
+  }
+
+  std::unique_ptr<Cursor> cursor() override {
+    return storage_.cursor();
+  }
+
+  std::unique_ptr<Cursor> rangeCursor(
+      const ByteView &lower, const std::optional<ByteView> &upper) override {
+    return storage_.rangeCursor(lower, upper);
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  InMemoryStorage storage_;
+};
+
+/**
+ * In-memory storage, which calls hook after each read, e.g. to write to
+ * cached storage while it reads backend.
+ */
+struct HookedStorage : InMemoryStorage {
+  outcome::result<std::optional<ByteVecOrView>> tryGet(
+      const ByteView &key) const override {
+    OUTCOME_TRY(value, InMemoryStorage::tryGet(key));
+    std::optional<ByteVec> copy;
+    if (value) {
+      copy = std::move(*value).intoByteVec();
+    }
+    if (hook) {
+      std::exchange(hook, nullptr)();
+    }
+    if (not copy) {
+      return std::nullopt;
+    }
+    return ByteVecOrView{std::move(*copy)};
+  }
+
+  mutable std::function<void()> hook;
+};
+
+struct CachedStorageTest : testing::Test {
+  jam::log::Logger logger =
+      testutil::prepareLoggers()->getLogger("CachedStorage", "testing");
+  std::shared_ptr<InMemoryStorage> backend =
+      std::make_shared<InMemoryStorage>();
+  CachedStorage db{backend, 1024, "test", logger};
+
+  std::vector<ByteVec> keys(BufferStorage &storage) {
+    std::vector<ByteVec> keys;
+    auto cursor = storage.cursor();
+    for (cursor->seekFirst().value(); cursor->isValid();
+         cursor->next().value()) {
+      EXPECT_EQ(cursor->value(), cursor->key());
+      keys.emplace_back(*cursor->key());
+    }
+    return keys;
+  }
+};
+
+/**
+ * @given cached storage over empty backend
+ * @when put and remove keys
+ * @then changes are visible through cache, and reach backend only on commit
+ */
+TEST_F(CachedStorageTest, WriteBack) {
+  ByteVec a{1}, b{2};
+  ASSERT_OUTCOME_SUCCESS(backend->put(b, ByteView{b}));
+  ASSERT_OUTCOME_SUCCESS(db.put(a, ByteView{a}));
+  ASSERT_OUTCOME_SUCCESS(db.remove(b));
+
+  ASSERT_OUTCOME_SUCCESS(value, db.get(a));
+  EXPECT_EQ(value, a);
+  ASSERT_OUTCOME_ERROR(db.get(b), StorageError::NOT_FOUND);
+  ASSERT_OUTCOME_SUCCESS(a_in_backend, backend->contains(a));
+  EXPECT_FALSE(a_in_backend);
+  EXPECT_EQ(db.pending(), 2);
+
+  ASSERT_OUTCOME_SUCCESS(db.commit());
+  EXPECT_EQ(db.pending(), 0);
+  ASSERT_OUTCOME_SUCCESS(a_committed, backend->contains(a));
+  EXPECT_TRUE(a_committed);
+  ASSERT_OUTCOME_SUCCESS(b_committed, backend->contains(b));
+  EXPECT_FALSE(b_committed);
+}
+
+/**
+ * @given cached storage over backend with {key}
+ * @when read {key} and absent key, then change backend behind cache
+ * @then cached value and cached absence are returned
+ */
+TEST_F(CachedStorageTest, ReadCache) {
+  ByteVec key{1}, absent{2}, other{3};
+  ASSERT_OUTCOME_SUCCESS(backend->put(key, ByteView{key}));
+  ASSERT_OUTCOME_SUCCESS(value, db.get(key));
+  EXPECT_EQ(value, key);
+  ASSERT_OUTCOME_SUCCESS(missing, db.tryGet(absent));
+  EXPECT_FALSE(missing);
+
+  ASSERT_OUTCOME_SUCCESS(backend->put(key, ByteView{other}));
+  ASSERT_OUTCOME_SUCCESS(backend->put(absent, ByteView{other}));
+  ASSERT_OUTCOME_SUCCESS(cached, db.get(key));
+  EXPECT_EQ(cached, key);
+  ASSERT_OUTCOME_SUCCESS(contains, db.contains(absent));
+  EXPECT_FALSE(contains);
+}
+
+/**
+ * @given cached storage with capacity for few entries
+ * @when read more entries than fit
+ * @then least recently used are evicted and read from backend again
+ */
+TEST_F(CachedStorageTest, Eviction) {
+  CachedStorage small{backend, 2 * (1 + 100), "small", logger};
+  ByteVec a{1}, b{2}, c{3}, value(100, 0), other(100, 1);
+  for (auto &key : {a, b, c}) {
+    ASSERT_OUTCOME_SUCCESS(backend->put(key, ByteView{value}));
+  }
+  ASSERT_OUTCOME_SUCCESS(small.get(a));
+  ASSERT_OUTCOME_SUCCESS(small.get(b));
+  ASSERT_OUTCOME_SUCCESS(small.get(a));
+  ASSERT_OUTCOME_SUCCESS(small.get(c));
+  for (auto &key : {a, b, c}) {
+    ASSERT_OUTCOME_SUCCESS(backend->put(key, ByteView{other}));
+  }
+  ASSERT_OUTCOME_SUCCESS(a_value, small.get(a));
+  EXPECT_EQ(a_value, value);
+  ASSERT_OUTCOME_SUCCESS(b_value, small.get(b));
+  EXPECT_EQ(b_value, other);
+}
+
+/**
+ * @given cached storage with buffered put, and backend entry
+ * @when read and write them through indexed batch and its child
+ * @then uncommitted buffered value and removal are read through batch, batch
+ * commit only buffers changes, and they reach backend with commit of storage
+ */
+TEST_F(CachedStorageTest, IndexedBatch) {
+  ByteVec a{1}, b{2}, c{3};
+  ASSERT_OUTCOME_SUCCESS(backend->put(a, ByteView{a}));
+  ASSERT_OUTCOME_SUCCESS(db.put(b, ByteView{b}));
+
+  auto batch = db.indexedBatch();
+  ASSERT_OUTCOME_SUCCESS(buffered, batch->get(b));
+  EXPECT_EQ(buffered, b);
+  ASSERT_OUTCOME_SUCCESS(db.remove(b));
+  ASSERT_OUTCOME_SUCCESS(buffered_removal, batch->contains(b));
+  EXPECT_FALSE(buffered_removal);
+  ASSERT_OUTCOME_SUCCESS(db.put(b, ByteView{b}));
+  ASSERT_OUTCOME_SUCCESS(batch->remove(a));
+  auto child = batch->child();
+  ASSERT_OUTCOME_SUCCESS(child->put(c, ByteView{c}));
+  ASSERT_OUTCOME_SUCCESS(removed, child->contains(a));
+  EXPECT_FALSE(removed);
+  ASSERT_OUTCOME_SUCCESS(child->commit());
+  ASSERT_OUTCOME_SUCCESS(not_yet, db.contains(c));
+  EXPECT_FALSE(not_yet);
+
+  ASSERT_OUTCOME_SUCCESS(batch->commit());
+  EXPECT_EQ(keys(db), (std::vector<ByteVec>{b, c}));
+  ASSERT_OUTCOME_SUCCESS(a_in_backend, backend->contains(a));
+  EXPECT_TRUE(a_in_backend);
+
+  ASSERT_OUTCOME_SUCCESS(db.commit());
+  EXPECT_EQ(keys(*backend), (std::vector<ByteVec>{b, c}));
+}
+
+/**
+ * @given backend entries and buffered changes interleaved with them
+ * @when iterate with cursor forward and backward
+ * @then entries of both are merged in order, removed ones are skipped
+ */
+TEST_F(CachedStorageTest, Cursor) {
+  for (uint8_t i : {1, 3, 5, 7}) {
+    ByteVec key{i};
+    ASSERT_OUTCOME_SUCCESS(backend->put(key, ByteView{key}));
+  }
+  for (uint8_t i : {0, 4, 8}) {
+    ByteVec key{i};
+    ASSERT_OUTCOME_SUCCESS(db.put(key, ByteView{key}));
+  }
+  ASSERT_OUTCOME_SUCCESS(db.remove(ByteVec{3}));
+  ASSERT_OUTCOME_SUCCESS(db.remove(ByteVec{7}));
+  ASSERT_OUTCOME_SUCCESS(db.put(ByteVec{5}, ByteView{ByteVec{5}}));
+
+  std::vector<ByteVec> expected{{0}, {1}, {4}, {5}, {8}};
+  EXPECT_EQ(keys(db), expected);
+
+  std::vector<ByteVec> reversed;
+  auto cursor = db.cursor();
+  for (cursor->seekLast().value(); cursor->isValid(); cursor->prev().value()) {
+    reversed.emplace_back(*cursor->key());
+  }
+  EXPECT_EQ(reversed, std::vector<ByteVec>(expected.rbegin(), expected.rend()));
+
+  ASSERT_OUTCOME_SUCCESS(found, cursor->seek(ByteVec{2}));
+  EXPECT_TRUE(found);
+  EXPECT_EQ(cursor->key(), ByteVec{4});
+  ASSERT_OUTCOME_SUCCESS(cursor->prev());
+  EXPECT_EQ(cursor->key(), ByteVec{1});
+  ASSERT_OUTCOME_SUCCESS(cursor->next());
+  EXPECT_EQ(cursor->key(), ByteVec{4});
+
+  ASSERT_OUTCOME_SUCCESS(db.commit());
+  EXPECT_EQ(keys(db), expected);
+}
+
+/**
+ * @given backend entries and buffered changes in and around range
+ * @when iterate with range cursor
+ * @then only merged entries within range are visited
+ */
+TEST_F(CachedStorageTest, RangeCursor) {
+  for (uint8_t i : {1, 3, 5, 7}) {
+    ByteVec key{i};
+    ASSERT_OUTCOME_SUCCESS(backend->put(key, ByteView{key}));
+  }
+  for (uint8_t i : {2, 4, 6}) {
+    ByteVec key{i};
+    ASSERT_OUTCOME_SUCCESS(db.put(key, ByteView{key}));
+  }
+  ASSERT_OUTCOME_SUCCESS(db.remove(ByteVec{5}));
+
+  ByteVec lower{2}, upper{6};
+  auto cursor = db.rangeCursor(lower, ByteView{upper});
+  std::vector<ByteVec> visited;
+  for (cursor->seekFirst().value(); cursor->isValid(); cursor->next().value()) {
+    EXPECT_EQ(*cursor->keyView(), *cursor->valueView());
+    visited.emplace_back(*cursor->key());
+  }
+  EXPECT_EQ(visited, (std::vector<ByteVec>{{2}, {3}, {4}}));
+
+  ASSERT_OUTCOME_SUCCESS(last, cursor->seekLast());
+  EXPECT_TRUE(last);
+  EXPECT_EQ(cursor->key(), ByteVec{4});
+}
+
+/**
+ * @given cached storage over backend with old value
+ * @when value is written and committed while cache misses and reads backend
+ * @then read returns and caches newer value instead of one read from backend
+ */
+TEST_F(CachedStorageTest, StaleReadNotCached) {
+  auto backend = std::make_shared<HookedStorage>();
+  CachedStorage cached{backend, 1024, "hooked", logger};
+  ByteVec key{1}, old_value{1}, new_value{2};
+  ASSERT_OUTCOME_SUCCESS(backend->put(key, ByteView{old_value}));
+  backend->hook = [&] {
+    ASSERT_OUTCOME_SUCCESS(cached.put(key, ByteView{new_value}));
+    ASSERT_OUTCOME_SUCCESS(cached.commit());
+  };
+
+  ASSERT_OUTCOME_SUCCESS(value, cached.get(key));
+  EXPECT_EQ(value, new_value);
+  ASSERT_OUTCOME_SUCCESS(cached_value, cached.get(key));
+  EXPECT_EQ(cached_value, new_value);
+}
+
+/**
+ * @given cached storage with capacity for few entries
+ * @when several threads read and iterate keys, while another one writes
+ * increasing values to them and commits some of writes
+ * @then readers never see value older than one seen before, and all writes
+ * reach backend
+ */
+TEST_F(CachedStorageTest, ConcurrentReaders) {
+  constexpr uint8_t kKeys = 16;
+  constexpr uint8_t kRounds = 100;
+  auto backend = std::make_shared<LockedStorage>();
+  CachedStorage small{backend, 4 * (1 + 1), "small", logger};
+  for (uint8_t i = 0; i < kKeys; ++i) {
+    ASSERT_OUTCOME_SUCCESS(backend->put(ByteVec{i}, ByteView{ByteVec{0}}));
+  }
+
+  std::atomic_bool stop = false;
+  std::atomic_size_t errors = 0;
+  std::vector<std::thread> readers;
+  for (size_t reader = 0; reader < 4; ++reader) {
+    readers.emplace_back([&] {
+      std::vector<uint8_t> seen(kKeys, 0);
+      while (not stop) {
+        for (uint8_t i = 0; i < kKeys; ++i) {
+          auto value = small.get(ByteVec{i});
+          if (not value or value.value().view().size() != 1
+              or value.value().view()[0] < seen[i]) {
+            ++errors;
+            continue;
+          }
+          seen[i] = value.value().view()[0];
+        }
+        size_t count = 0;
+        auto cursor = small.cursor();
+        auto step = cursor->seekFirst().has_value();
+        while (step and cursor->isValid()) {
+          ++count;
+          step = cursor->next().has_value();
+        }
+        if (count != kKeys) {
+          ++errors;
+        }
+      }
+    });
+  }
+
+  for (uint8_t round = 1; round <= kRounds; ++round) {
+    for (uint8_t i = 0; i < kKeys; ++i) {
+      ASSERT_OUTCOME_SUCCESS(small.put(ByteVec{i}, ByteView{ByteVec{round}}));
+    }
+    if (round % 3 == 0) {
+      ASSERT_OUTCOME_SUCCESS(small.commit());
+    }
+  }
+  stop = true;
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(errors, 0);
+
+  ASSERT_OUTCOME_SUCCESS(small.commit());
+  for (uint8_t i = 0; i < kKeys; ++i) {
+    ASSERT_OUTCOME_SUCCESS(value, backend->get(ByteVec{i}));
+    EXPECT_EQ(value, ByteVec{kRounds});
+  }
+}
@@ -0,0 +1,105 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <qtils/test/outcome.hpp>
+
+#include "storage/in_memory/in_memory_spaced_storage.hpp"
+
+using namespace jam::storage;
+
+struct InMemorySpacedStorageTest : testing::Test {
+  InMemorySpacedStorage db;
+};
+
+/**
+ * @given storage with entries
+ * @when take snapshot, then change and remove entries of storage
+ * @then snapshot keeps entries as of its creation, including iteration
+ */
+TEST_F(InMemorySpacedStorageTest, SnapshotIsDeepCopy) {
+  auto space = db.getSpace(Space::Default);
+  ByteVec a{1}, b{2}, c{3};
+  ASSERT_OUTCOME_SUCCESS(space->put(a, ByteView{a}));
+  ASSERT_OUTCOME_SUCCESS(space->put(b, ByteView{b}));
+
+  auto snapshot = db.snapshot();
+  auto old_space = snapshot->getSpace(Space::Default);
+
+  ASSERT_OUTCOME_SUCCESS(space->put(a, ByteView{c}));
+  ASSERT_OUTCOME_SUCCESS(space->remove(b));
+  ASSERT_OUTCOME_SUCCESS(space->put(c, ByteView{c}));
+
+  ASSERT_OUTCOME_SUCCESS(value_a, old_space->get(a));
+  EXPECT_EQ(value_a, a);
+  ASSERT_OUTCOME_SUCCESS(value_b, old_space->get(b));
+  EXPECT_EQ(value_b, b);
+  ASSERT_OUTCOME_SUCCESS(has_c, old_space->contains(c));
+  EXPECT_FALSE(has_c);
+
+  std::vector<ByteVec> keys;
+  auto cursor = old_space->cursor();
+  ASSERT_OUTCOME_SUCCESS(cursor->seekFirst());
+  while (cursor->isValid()) {
+    keys.emplace_back(*cursor->key());
+    ASSERT_OUTCOME_SUCCESS(cursor->next());
+  }
+  EXPECT_EQ(keys, (std::vector<ByteVec>{a, b}));
+
+  // Storage is not affected by snapshot being released
+  snapshot.reset();
+  old_space.reset();
+  ASSERT_OUTCOME_SUCCESS(value_c, space->get(a));
+  EXPECT_EQ(value_c, c);
+}
+
+/**
+ * @given storage, whose space was never used
+ * @when take snapshot, then write to space
+ * @then space of snapshot is empty
+ */
+TEST_F(InMemorySpacedStorageTest, SnapshotOfUnusedSpace) {
+  auto snapshot = db.snapshot();
+  ByteVec a{1};
+  ASSERT_OUTCOME_SUCCESS(db.getSpace(Space::Default)->put(a, ByteView{a}));
+  ASSERT_OUTCOME_SUCCESS(
+      missing, snapshot->getSpace(Space::Default)->tryGet(a));
+  EXPECT_FALSE(missing.has_value());
+}
+
+/**
+ * @given storage with entry
+ * @when put and remove keys by spaced batch, and commit it
+ * @then changes are invisible until commit, and applied by it; cleared batch
+ * commits nothing
+ */
+TEST_F(InMemorySpacedStorageTest, Batch) {
+  auto space = db.getSpace(Space::Default);
+  ByteVec a{1}, b{2};
+  ASSERT_OUTCOME_SUCCESS(space->put(a, ByteView{a}));
+
+  auto batch = db.batch();
+  ASSERT_OUTCOME_SUCCESS(batch->remove(Space::Default, a));
+  ASSERT_OUTCOME_SUCCESS(batch->put(Space::Default, b, ByteView{b}));
+  ASSERT_OUTCOME_SUCCESS(has_a, space->contains(a));
+  EXPECT_TRUE(has_a);
+  ASSERT_OUTCOME_SUCCESS(has_b, space->contains(b));
+  EXPECT_FALSE(has_b);
+
+  ASSERT_OUTCOME_SUCCESS(batch->commit());
+  ASSERT_OUTCOME_SUCCESS(has_a_, space->contains(a));
+  EXPECT_FALSE(has_a_);
+  ASSERT_OUTCOME_SUCCESS(value_b, space->get(b));
+  EXPECT_EQ(value_b, b);
+
+  batch->clear();
+  ASSERT_OUTCOME_SUCCESS(batch->put(Space::Default, a, ByteView{a}));
+  batch->clear();
+  ASSERT_OUTCOME_SUCCESS(batch->commit());
+  ASSERT_OUTCOME_SUCCESS(has_a__, space->contains(a));
+  EXPECT_FALSE(has_a__);
+}
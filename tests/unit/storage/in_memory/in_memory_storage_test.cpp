@@ -0,0 +1,230 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <qtils/test/outcome.hpp>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/storage_error.hpp"
+
+using namespace jam::storage;
+
+struct InMemoryStorageTest : testing::Test {
+  InMemoryStorage db;
+};
+
+/**
+ * @given storage with {key}
+ * @when put other value by {key}, then remove it
+ * @then reads and size hint reflect each change
+ */
+TEST_F(InMemoryStorageTest, PutGetRemove) {
+  ByteVec key{1, 3, 3, 7};
+  ByteVec value1{1, 2, 3};
+  ByteVec value2{4, 5};
+
+  ASSERT_OUTCOME_SUCCESS(db.put(key, ByteView{value1}));
+  ASSERT_OUTCOME_SUCCESS(value, db.get(key));
+  EXPECT_EQ(value, value1);
+  EXPECT_EQ(db.byteSizeHint(), value1.size());
+
+  ASSERT_OUTCOME_SUCCESS(db.put(key, ByteView{value2}));
+  ASSERT_OUTCOME_SUCCESS(value_, db.get(key));
+  EXPECT_EQ(value_, value2);
+  EXPECT_EQ(db.byteSizeHint(), value2.size());
+
+  ASSERT_OUTCOME_SUCCESS(db.remove(key));
+  ASSERT_OUTCOME_SUCCESS(contains, db.contains(key));
+  EXPECT_FALSE(contains);
+  ASSERT_OUTCOME_ERROR(db.get(key), StorageError::NOT_FOUND);
+  ASSERT_OUTCOME_SUCCESS(missing, db.tryGet(key));
+  EXPECT_FALSE(missing.has_value());
+  EXPECT_EQ(db.byteSizeHint(), 0);
+}
+
+/**
+ * @given storage with keys of different lengths
+ * @when iterate with cursor forward and backward
+ * @then keys are visited in lexicographic order of bytes
+ */
+TEST_F(InMemoryStorageTest, CursorOrder) {
+  std::vector<ByteVec> keys{{0}, {0, 0}, {0, 1}, {1}, {1, 0, 0}, {2}, {0xff}};
+  for (auto it = keys.rbegin(); it != keys.rend(); ++it) {
+    ASSERT_OUTCOME_SUCCESS(db.put(*it, ByteView{*it}));
+  }
+
+  auto cursor = db.cursor();
+  std::vector<ByteVec> forward;
+  ASSERT_OUTCOME_SUCCESS(cursor->seekFirst());
+  for (; cursor->isValid(); cursor->next().value()) {
+    EXPECT_EQ(cursor->value().value(), cursor->key().value());
+    forward.emplace_back(cursor->key().value());
+  }
+  EXPECT_EQ(forward, keys);
+
+  std::vector<ByteVec> backward;
+  ASSERT_OUTCOME_SUCCESS(cursor->seekLast());
+  for (; cursor->isValid(); cursor->prev().value()) {
+    backward.emplace(backward.begin(), cursor->key().value());
+  }
+  EXPECT_EQ(backward, keys);
+
+  ASSERT_OUTCOME_SUCCESS(found, cursor->seek(ByteVec{1, 0}));
+  EXPECT_TRUE(found);
+  EXPECT_EQ(cursor->key(), (ByteVec{1, 0, 0}));
+}
+
+/**
+ * @given cursor at some entry
+ * @when that entry is removed
+ * @then cursor moves to the next remaining entry
+ */
+TEST_F(InMemoryStorageTest, CursorSurvivesRemoval) {
+  for (uint8_t i = 0; i < 4; ++i) {
+    ASSERT_OUTCOME_SUCCESS(db.put(ByteVec{i}, ByteView{ByteVec{i}}));
+  }
+  auto cursor = db.cursor();
+  ASSERT_OUTCOME_SUCCESS(cursor->seek(ByteVec{1}));
+  ASSERT_OUTCOME_SUCCESS(db.remove(ByteVec{1}));
+  EXPECT_FALSE(cursor->value().has_value());
+  ASSERT_OUTCOME_SUCCESS(cursor->next());
+  EXPECT_EQ(cursor->key(), (ByteVec{2}));
+}
+
+/**
+ * @given storage with {key}
+ * @when batch puts other keys and removes {key}
+ * @then changes are applied only on commit
+ */
+TEST_F(InMemoryStorageTest, Batch) {
+  ByteVec key{1};
+  ASSERT_OUTCOME_SUCCESS(db.put(key, ByteView{key}));
+
+  auto batch = db.batch();
+  for (uint8_t i = 2; i < 5; ++i) {
+    ASSERT_OUTCOME_SUCCESS(batch->put(ByteVec{i}, ByteView{ByteVec{i}}));
+  }
+  ASSERT_OUTCOME_SUCCESS(batch->remove(key));
+  ASSERT_OUTCOME_SUCCESS(contains_before, db.contains(key));
+  EXPECT_TRUE(contains_before);
+
+  ASSERT_OUTCOME_SUCCESS(batch->commit());
+  ASSERT_OUTCOME_SUCCESS(contains_after, db.contains(key));
+  EXPECT_FALSE(contains_after);
+  for (uint8_t i = 2; i < 5; ++i) {
+    ASSERT_OUTCOME_SUCCESS(value, db.get(ByteVec{i}));
+    EXPECT_EQ(value, (ByteVec{i}));
+  }
+}
+
+/**
+ * @given storage with {key}
+ * @when absent key is removed in indexed batch, removed key is put back in
+ * its child, and another child is cleared or discarded
+ * @then batch reads its own writes, and only committed changes reach storage,
+ * with parent commit
+ */
+TEST_F(InMemoryStorageTest, IndexedBatch) {
+  ByteVec key{1}, absent{2}, other{9}, dropped{8};
+  ASSERT_OUTCOME_SUCCESS(db.put(key, ByteView{key}));
+
+  auto batch = db.indexedBatch();
+  ASSERT_OUTCOME_SUCCESS(batch->remove(absent));
+  ASSERT_OUTCOME_SUCCESS(batch->remove(key));
+  ASSERT_OUTCOME_SUCCESS(removed, batch->contains(key));
+  EXPECT_FALSE(removed);
+
+  auto child = batch->child();
+  ASSERT_OUTCOME_ERROR(child->get(key), StorageError::NOT_FOUND);
+  ASSERT_OUTCOME_SUCCESS(child->put(key, ByteView{other}));
+  ASSERT_OUTCOME_SUCCESS(restored, child->get(key));
+  EXPECT_EQ(restored, other);
+  ASSERT_OUTCOME_SUCCESS(child->commit());
+
+  auto cleared = batch->child();
+  ASSERT_OUTCOME_SUCCESS(cleared->put(dropped, ByteView{dropped}));
+  cleared->clear();
+  ASSERT_OUTCOME_SUCCESS(after_clear, cleared->contains(dropped));
+  EXPECT_FALSE(after_clear);
+  ASSERT_OUTCOME_SUCCESS(cleared->commit());
+  auto discarded = batch->child();
+  ASSERT_OUTCOME_SUCCESS(discarded->put(dropped, ByteView{dropped}));
+  discarded.reset();
+
+  ASSERT_OUTCOME_SUCCESS(moved, batch->get(key));
+  EXPECT_EQ(moved, other);
+  ASSERT_OUTCOME_SUCCESS(not_yet, db.get(key));
+  EXPECT_EQ(not_yet, key);
+
+  ASSERT_OUTCOME_SUCCESS(batch->commit());
+  ASSERT_OUTCOME_SUCCESS(replaced, db.get(key));
+  EXPECT_EQ(replaced, other);
+  ASSERT_OUTCOME_SUCCESS(still_absent, db.contains(absent));
+  EXPECT_FALSE(still_absent);
+  ASSERT_OUTCOME_SUCCESS(never, db.contains(dropped));
+  EXPECT_FALSE(never);
+}
+
+/**
+ * @given storage with some of keys
+ * @when read all keys at once
+ * @then values are returned in order of keys, absent keys are std::nullopt
+ */
+TEST_F(InMemoryStorageTest, MultiGet) {
+  ByteVec a{1}, b{2}, c{3};
+  ASSERT_OUTCOME_SUCCESS(db.put(a, ByteView{a}));
+  ASSERT_OUTCOME_SUCCESS(db.put(c, ByteView{c}));
+
+  std::vector<ByteView> keys{c, b, a, c};
+  ASSERT_OUTCOME_SUCCESS(values, db.multiGet(keys));
+  ASSERT_EQ(values.size(), keys.size());
+  EXPECT_EQ(values[0], c);
+  EXPECT_FALSE(values[1].has_value());
+  EXPECT_EQ(values[2], a);
+  EXPECT_EQ(values[3], c);
+}
+
+/**
+ * @given storage with keys of several prefixes, including 0xff ones
+ * @when iterate with prefix cursors forward and backward
+ * @then only keys with prefix are visited, through views of entries
+ */
+TEST_F(InMemoryStorageTest, PrefixCursor) {
+  for (ByteVec key : std::vector<ByteVec>{
+           {0}, {1}, {1, 0}, {1, 0xff}, {2}, {0xff}, {0xff, 1}}) {
+    ASSERT_OUTCOME_SUCCESS(db.put(key, ByteView{key}));
+  }
+
+  auto cursor = db.prefixCursor(ByteVec{1});
+  std::vector<ByteVec> forward;
+  for (cursor->seekFirst().value(); cursor->isValid(); cursor->next().value()) {
+    EXPECT_EQ(*cursor->keyView(), *cursor->valueView());
+    forward.emplace_back(*cursor->key());
+  }
+  EXPECT_EQ(forward, (std::vector<ByteVec>{{1}, {1, 0}, {1, 0xff}}));
+
+  ASSERT_OUTCOME_SUCCESS(last, cursor->seekLast());
+  EXPECT_TRUE(last);
+  EXPECT_EQ(cursor->key(), (ByteVec{1, 0xff}));
+  ASSERT_OUTCOME_SUCCESS(before, cursor->seek(ByteVec{0}));
+  EXPECT_TRUE(before);
+  EXPECT_EQ(cursor->key(), ByteVec{1});
+  ASSERT_OUTCOME_SUCCESS(cursor->prev());
+  EXPECT_FALSE(cursor->isValid());
+
+  auto tail = db.prefixCursor(ByteVec{0xff});
+  ASSERT_OUTCOME_SUCCESS(tail_last, tail->seekLast());
+  EXPECT_TRUE(tail_last);
+  EXPECT_EQ(tail->key(), (ByteVec{0xff, 1}));
+
+  auto empty = db.prefixCursor(ByteVec{3});
+  ASSERT_OUTCOME_SUCCESS(found, empty->seekFirst());
+  EXPECT_FALSE(found);
+  EXPECT_FALSE(empty->keyView().has_value());
+}
@@ -6,13 +6,18 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
 #include <exception>
+#include <optional>
+#include <vector>
 
 #include <qtils/test/outcome.hpp>
 
 #include "testutil/storage/base_rocksdb_test.hpp"
 
+#include "metrics/impl/prometheus/registry_impl.hpp"
+#include "storage/cached/cached_storage.hpp"
 #include "storage/rocksdb/rocksdb.hpp"
 #include "storage/storage_error.hpp"
 
@@ -23,6 +28,26 @@ struct RocksDb_Integration_Test : public test::BaseRocksDB_Test {
   RocksDb_Integration_Test()
       : test::BaseRocksDB_Test("/tmp/kagome_rocksdb_integration_test") {}
 
+  /// Value of gauge `name` with label `space`, if any, after collection
+  static std::optional<double> gauge(const std::string &name,
+                                     const std::string &space = "") {
+    for (auto &family :
+         jam::metrics::PrometheusRegistry::registry()->Collect()) {
+      if (family.name != name) {
+        continue;
+      }
+      for (auto &metric : family.metric) {
+        auto labeled = std::ranges::any_of(metric.label, [&](auto &label) {
+          return label.name == "space" and label.value == space;
+        });
+        if (space.empty() or labeled) {
+          return metric.gauge.value;
+        }
+      }
+    }
+    return std::nullopt;
+  }
+
   Buffer key_{1, 3, 3, 7};
   Buffer value_{1, 2, 3};
 };
@@ -40,6 +65,61 @@ TEST_F(RocksDb_Integration_Test, Put_Get) {
   EXPECT_EQ(val, value_);
 }
 
+/**
+ * @given opened database, with {key}
+ * @when read {key} without copying, after memtable is flushed
+ * @then pinned {value} is correct, missing key is not found
+ */
+TEST_F(RocksDb_Integration_Test, GetPinned) {
+  auto space = std::dynamic_pointer_cast<RocksDbSpace>(db_);
+  ASSERT_TRUE(space);
+  ASSERT_OUTCOME_SUCCESS(db_->put(key_, BufferView{value_}));
+  space->compact({}, {});
+
+  ASSERT_OUTCOME_SUCCESS(pinned, space->tryGetPinned(key_));
+  ASSERT_TRUE(pinned);
+  EXPECT_EQ(pinned->view(), value_);
+  ASSERT_OUTCOME_SUCCESS(contains, db_->contains(key_));
+  EXPECT_TRUE(contains);
+
+  ASSERT_OUTCOME_SUCCESS(missing, space->tryGetPinned(Buffer{1, 2}));
+  EXPECT_FALSE(missing);
+  ASSERT_OUTCOME_SUCCESS(contains_missing, db_->contains(Buffer{1, 2}));
+  EXPECT_FALSE(contains_missing);
+}
+
+/**
+ * @given snapshot of database with {key}
+ * @when {key} is changed and other key is added after snapshot
+ * @then snapshot reads and iterates over state as of its creation
+ */
+TEST_F(RocksDb_Integration_Test, Snapshot) {
+  Buffer other{9};
+  ASSERT_OUTCOME_SUCCESS(db_->put(key_, BufferView{value_}));
+  auto snapshot = rocks_->snapshot();
+  auto space = snapshot->getSpace(Space::Default);
+
+  ASSERT_OUTCOME_SUCCESS(db_->put(key_, BufferView{other}));
+  ASSERT_OUTCOME_SUCCESS(db_->put(other, BufferView{other}));
+
+  ASSERT_OUTCOME_SUCCESS(val, space->get(key_));
+  EXPECT_EQ(val, value_);
+  ASSERT_OUTCOME_SUCCESS(contains, space->contains(other));
+  EXPECT_FALSE(contains);
+  ASSERT_OUTCOME_SUCCESS(current, db_->get(key_));
+  EXPECT_EQ(current, other);
+
+  snapshot.reset();
+  auto cursor = space->cursor();
+  size_t count = 0;
+  for (cursor->seekFirst().value(); cursor->isValid();
+       cursor->next().value()) {
+    EXPECT_EQ(cursor->key(), key_);
+    ++count;
+  }
+  EXPECT_EQ(count, 1);
+}
+
 /**
  * @given empty db
  * @when read {key}
@@ -84,6 +164,305 @@ TEST_F(RocksDb_Integration_Test, WriteBatch) {
   EXPECT_FALSE(contains);
 }
 
+/**
+ * @given database with [(i,i) for i in range(0, 100, 2)]
+ * @when read all keys in range(100) at once, partly after flush
+ * @then values are returned in order of keys, odd keys are absent
+ */
+TEST_F(RocksDb_Integration_Test, MultiGet) {
+  std::vector<Buffer> keys;
+  for (uint8_t i = 0; i < 100; ++i) {
+    keys.emplace_back(1, i);
+    if (i % 2 == 0) {
+      ASSERT_OUTCOME_SUCCESS(db_->put(keys.back(), BufferView{keys.back()}));
+    }
+    if (i == 50) {
+      std::dynamic_pointer_cast<RocksDbSpace>(db_)->compact({}, {});
+    }
+  }
+
+  std::vector<BufferView> views(keys.begin(), keys.end());
+  ASSERT_OUTCOME_SUCCESS(values, db_->multiGet(views));
+  ASSERT_EQ(values.size(), keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (i % 2 == 0) {
+      EXPECT_EQ(values[i], keys[i]);
+    } else {
+      EXPECT_FALSE(values[i].has_value());
+    }
+  }
+}
+
+/**
+ * @given database with {key}
+ * @when put and remove keys through batch of spaced storage
+ * @then changes are visible only after commit
+ */
+TEST_F(RocksDb_Integration_Test, SpacedBatch) {
+  Buffer other{9};
+  ASSERT_OUTCOME_SUCCESS(db_->put(key_, BufferView{value_}));
+
+  auto batch = rocks_->batch();
+  ASSERT_OUTCOME_SUCCESS(batch->put(Space::Default, other, BufferView{other}));
+  ASSERT_OUTCOME_SUCCESS(batch->remove(Space::Default, key_));
+  ASSERT_OUTCOME_SUCCESS(not_yet, db_->contains(other));
+  EXPECT_FALSE(not_yet);
+
+  ASSERT_OUTCOME_SUCCESS(batch->commit(true));
+  ASSERT_OUTCOME_SUCCESS(added, db_->contains(other));
+  EXPECT_TRUE(added);
+  ASSERT_OUTCOME_SUCCESS(removed, db_->contains(key_));
+  EXPECT_FALSE(removed);
+}
+
+/**
+ * @given database with write-back cached default space, with buffered
+ * changes of keys
+ * @when batch changes some of those keys and other keys, and is committed
+ * @then changes of batch and buffered changes of other keys appear at once,
+ * cache returns values of batch, and both are durable
+ */
+TEST_F(RocksDb_Integration_Test, SpacedBatchCachedSpace) {
+  Buffer buffered{8};
+  Buffer other{9};
+  Buffer late{10};
+  db_config.cached_columns = {{"default", 1 << 10}};
+  open();
+  auto cached = std::dynamic_pointer_cast<CachedStorage>(db_);
+  ASSERT_TRUE(cached);
+  ASSERT_OUTCOME_SUCCESS(db_->put(key_, BufferView{value_}));
+  ASSERT_OUTCOME_SUCCESS(db_->put(buffered, BufferView{value_}));
+
+  // Snapshot flushes buffered changes first
+  auto before = rocks_->snapshot();
+  EXPECT_EQ(cached->pending(), 0);
+
+  ASSERT_OUTCOME_SUCCESS(db_->put(other, BufferView{value_}));
+  ASSERT_OUTCOME_SUCCESS(db_->put(late, BufferView{value_}));
+  auto batch = rocks_->batch();
+  ASSERT_OUTCOME_SUCCESS(batch->remove(Space::Default, key_));
+  ASSERT_OUTCOME_SUCCESS(batch->put(Space::Default, other, BufferView{other}));
+  ASSERT_OUTCOME_SUCCESS(batch->commit(true));
+  EXPECT_EQ(cached->pending(), 0);
+  auto after = rocks_->snapshot();
+
+  // Snapshots of database see none or all changes
+  auto old_space = before->getSpace(Space::Default);
+  ASSERT_OUTCOME_SUCCESS(old_key, old_space->get(key_));
+  EXPECT_EQ(old_key, value_);
+  ASSERT_OUTCOME_SUCCESS(old_buffered, old_space->get(buffered));
+  EXPECT_EQ(old_buffered, value_);
+  ASSERT_OUTCOME_SUCCESS(no_other, old_space->contains(other));
+  EXPECT_FALSE(no_other);
+  ASSERT_OUTCOME_SUCCESS(no_late, old_space->contains(late));
+  EXPECT_FALSE(no_late);
+  auto new_space = after->getSpace(Space::Default);
+  ASSERT_OUTCOME_SUCCESS(removed, new_space->contains(key_));
+  EXPECT_FALSE(removed);
+  ASSERT_OUTCOME_SUCCESS(replaced, new_space->get(other));
+  EXPECT_EQ(replaced, other);
+  ASSERT_OUTCOME_SUCCESS(written, new_space->get(late));
+  EXPECT_EQ(written, value_);
+
+  // Cache is not stale
+  ASSERT_OUTCOME_SUCCESS(cached_removed, db_->contains(key_));
+  EXPECT_FALSE(cached_removed);
+  ASSERT_OUTCOME_SUCCESS(cached_other, db_->get(other));
+  EXPECT_EQ(cached_other, other);
+
+  // Batch, snapshots and spaces keep database, and so its lock
+  batch.reset();
+  old_space.reset();
+  new_space.reset();
+  before.reset();
+  after.reset();
+  cached.reset();
+  db_config.cached_columns.clear();
+  open();
+  ASSERT_OUTCOME_SUCCESS(reopened_other, db_->get(other));
+  EXPECT_EQ(reopened_other, other);
+  ASSERT_OUTCOME_SUCCESS(reopened_late, db_->get(late));
+  EXPECT_EQ(reopened_late, value_);
+  ASSERT_OUTCOME_SUCCESS(reopened_removed, db_->contains(key_));
+  EXPECT_FALSE(reopened_removed);
+}
+
+/**
+ * @given database with {key}
+ * @when key is removed and put again in indexed batch, and removed again in
+ * its child
+ * @then only latest change of key is read from each batch, and value read
+ * from database has no TTL suffix
+ */
+TEST_F(RocksDb_Integration_Test, IndexedBatch) {
+  Buffer other{9};
+  ASSERT_OUTCOME_SUCCESS(db_->put(key_, BufferView{value_}));
+
+  auto batch = db_->indexedBatch();
+  ASSERT_OUTCOME_SUCCESS(from_db, batch->get(key_));
+  EXPECT_EQ(from_db, value_);
+  ASSERT_OUTCOME_SUCCESS(batch->remove(key_));
+  ASSERT_OUTCOME_SUCCESS(removed, batch->contains(key_));
+  EXPECT_FALSE(removed);
+  ASSERT_OUTCOME_SUCCESS(batch->put(key_, BufferView{other}));
+  ASSERT_OUTCOME_SUCCESS(put_again, batch->get(key_));
+  EXPECT_EQ(put_again, other);
+
+  auto child = batch->child();
+  ASSERT_OUTCOME_SUCCESS(from_parent, child->get(key_));
+  EXPECT_EQ(from_parent, other);
+  ASSERT_OUTCOME_SUCCESS(child->remove(key_));
+  ASSERT_OUTCOME_ERROR(child->get(key_), StorageError::NOT_FOUND);
+  ASSERT_OUTCOME_SUCCESS(still_in_parent, batch->get(key_));
+  EXPECT_EQ(still_in_parent, other);
+  child->clear();
+  ASSERT_OUTCOME_SUCCESS(cleared, child->get(key_));
+  EXPECT_EQ(cleared, other);
+  ASSERT_OUTCOME_SUCCESS(child->remove(key_));
+  ASSERT_OUTCOME_SUCCESS(child->commit());
+
+  ASSERT_OUTCOME_SUCCESS(not_yet, db_->get(key_));
+  EXPECT_EQ(not_yet, value_);
+  ASSERT_OUTCOME_SUCCESS(batch->commit());
+  ASSERT_OUTCOME_SUCCESS(gone, db_->contains(key_));
+  EXPECT_FALSE(gone);
+}
+
+/**
+ * @given database with keys of several prefixes
+ * @when iterate with prefix cursor forward and backward
+ * @then only keys with prefix are visited, through views of entries
+ */
+TEST_F(RocksDb_Integration_Test, PrefixCursor) {
+  for (Buffer key : std::vector<Buffer>{{0}, {1}, {1, 0}, {1, 0xff}, {2}}) {
+    ASSERT_OUTCOME_SUCCESS(db_->put(key, BufferView{key}));
+  }
+
+  auto cursor = db_->prefixCursor(Buffer{1});
+  std::vector<Buffer> forward;
+  for (cursor->seekFirst().value(); cursor->isValid(); cursor->next().value()) {
+    EXPECT_EQ(*cursor->keyView(), *cursor->valueView());
+    forward.emplace_back(*cursor->key());
+  }
+  EXPECT_EQ(forward, (std::vector<Buffer>{{1}, {1, 0}, {1, 0xff}}));
+
+  ASSERT_OUTCOME_SUCCESS(last, cursor->seekLast());
+  EXPECT_TRUE(last);
+  EXPECT_EQ(cursor->key(), (Buffer{1, 0xff}));
+  ASSERT_OUTCOME_SUCCESS(cursor->prev());
+  EXPECT_EQ(cursor->key(), (Buffer{1, 0}));
+}
+
+/**
+ * @given space with prefix extractor of 2 bytes, with keys of several
+ * prefixes flushed to table files and in memtable
+ * @when iterate with plain cursor, and with prefix cursors shorter than
+ * and as long as prefix of space
+ * @then plain cursor visits keys of all prefixes in both directions, prefix
+ * cursors visit only keys with their prefix
+ */
+TEST_F(RocksDb_Integration_Test, PrefixExtractor) {
+  db_config.column_prefix_length = {{"default", 2}};
+  open();
+  std::vector<Buffer> keys{
+      {0, 0, 1}, {0, 1}, {0, 1, 7}, {1, 0}, {1, 0, 5}, {1, 2}, {2, 0, 0}};
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_OUTCOME_SUCCESS(db_->put(keys[i], BufferView{keys[i]}));
+    if (i == 3) {
+      std::dynamic_pointer_cast<RocksDbSpace>(db_)->compact({}, {});
+    }
+  }
+
+  auto collect = [](auto &cursor, bool forward) {
+    std::vector<Buffer> visited;
+    while (cursor->isValid()) {
+      visited.emplace_back(*cursor->key());
+      EXPECT_TRUE(forward ? cursor->next() : cursor->prev());
+    }
+    return visited;
+  };
+
+  auto cursor = db_->cursor();
+  ASSERT_OUTCOME_SUCCESS(cursor->seek(Buffer{0, 1}));
+  EXPECT_EQ(collect(cursor, true),
+            std::vector<Buffer>(keys.begin() + 1, keys.end()));
+  ASSERT_OUTCOME_SUCCESS(cursor->seekReverse(Buffer{1, 1}));
+  EXPECT_EQ(collect(cursor, false),
+            std::vector<Buffer>(keys.rbegin() + 2, keys.rend()));
+
+  auto short_prefix = db_->prefixCursor(Buffer{1});
+  ASSERT_OUTCOME_SUCCESS(short_prefix->seekFirst());
+  EXPECT_EQ(collect(short_prefix, true),
+            (std::vector<Buffer>{{1, 0}, {1, 0, 5}, {1, 2}}));
+
+  auto full_prefix = db_->prefixCursor(Buffer{1, 0});
+  ASSERT_OUTCOME_SUCCESS(full_prefix->seekLast());
+  EXPECT_EQ(collect(full_prefix, false),
+            (std::vector<Buffer>{{1, 0, 5}, {1, 0}}));
+}
+
+/**
+ * @given database config with cache share of misspelled space
+ * @when database is opened
+ * @then it is rejected instead of shrinking shared cache by that share
+ */
+TEST_F(RocksDb_Integration_Test, UnknownSpaceName) {
+  db_.reset();
+  rocks_.reset();
+  db_config.column_cache_size["defualt"] = 0.5;
+  EXPECT_ANY_THROW(std::make_shared<RocksDB>(logsys, app_config));
+
+  db_config.column_cache_size = {{"default", 0.5}};
+  open();
+  ASSERT_OUTCOME_SUCCESS(db_->put(key_, BufferView{value_}));
+}
+
+/**
+ * @given database with write-back cached space
+ * @when values are written to space, then database is flushed, or closed
+ * while space is still referenced
+ * @then buffered values are written to database in both cases
+ */
+TEST_F(RocksDb_Integration_Test, CachedSpaceFlush) {
+  Buffer other{9};
+  db_config.cached_columns = {{"default", 1 << 10}};
+  open();
+  auto cached = std::dynamic_pointer_cast<CachedStorage>(db_);
+  ASSERT_TRUE(cached);
+
+  ASSERT_OUTCOME_SUCCESS(db_->put(key_, BufferView{value_}));
+  EXPECT_EQ(cached->pending(), 1);
+  ASSERT_OUTCOME_SUCCESS(rocks_->flush());
+  EXPECT_EQ(cached->pending(), 0);
+
+  ASSERT_OUTCOME_SUCCESS(db_->put(other, BufferView{value_}));
+  db_config.cached_columns.clear();
+  open();
+  EXPECT_EQ(cached->pending(), 0);
+  for (auto &key : {key_, other}) {
+    ASSERT_OUTCOME_SUCCESS(value, db_->get(key));
+    EXPECT_EQ(value, value_);
+  }
+}
+
+/**
+ * @given database with written value
+ * @when metrics are collected
+ * @then sizes of storage and of its only space include memtable
+ */
+TEST_F(RocksDb_Integration_Test, Metrics) {
+  ASSERT_OUTCOME_SUCCESS(db_->put(key_, BufferView{value_}));
+  jam::metrics::PrometheusRegistry::runCollectors();
+
+  auto memtable = gauge("jam_rocksdb_memtable_size", "default");
+  ASSERT_TRUE(memtable.has_value());
+  EXPECT_GT(*memtable, 0);
+  auto space = gauge("jam_rocksdb_space_size", "default");
+  ASSERT_TRUE(space.has_value());
+  EXPECT_GE(*space, *memtable);
+  EXPECT_EQ(gauge("jam_storage_size"), space);
+}
+
 /**
  * @given database with [(i,i) for i in range(100)]
  * @when iterate over kv pairs forward and backward
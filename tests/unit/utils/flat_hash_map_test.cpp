@@ -0,0 +1,160 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory_resource>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <qtils/byte_arr.hpp>
+
+#include "utils/flat_hash_map.hpp"
+
+using jam::FlatHashMap;
+using jam::FlatHashSet;
+using Key = qtils::ByteArr<32>;
+
+struct FlatHashMapTest : testing::Test {
+  Key randomKey() {
+    Key key;
+    for (auto &byte : key) {
+      byte = static_cast<uint8_t>(random());
+    }
+    return key;
+  }
+
+  std::mt19937_64 random{0};
+};
+
+/**
+ * @given empty map
+ * @when insert, find and erase keys
+ * @then map behaves as std::map with the same operations
+ */
+TEST_F(FlatHashMapTest, MatchesStdMap) {
+  FlatHashMap<Key, int> map;
+  std::map<Key, int> expected;
+  std::vector<Key> keys;
+  for (int i = 0; i < 1000; ++i) {
+    keys.emplace_back(randomKey());
+  }
+  for (int i = 0; i < 10000; ++i) {
+    auto &key = keys[random() % keys.size()];
+    switch (random() % 3) {
+      case 0:
+        map[key] += i;
+        expected[key] += i;
+        break;
+      case 1:
+        EXPECT_EQ(map.erase(key), expected.erase(key));
+        break;
+      case 2:
+        EXPECT_EQ(map.contains(key), expected.contains(key));
+        break;
+    }
+    ASSERT_EQ(map.size(), expected.size());
+  }
+  size_t n = 0;
+  for (auto &[key, value] : map) {
+    EXPECT_EQ(expected.at(key), value);
+    ++n;
+  }
+  EXPECT_EQ(n, expected.size());
+}
+
+/**
+ * @given map with keys erased and inserted many times
+ * @when number of live keys stays small
+ * @then deleted slots are reused instead of growing table
+ */
+TEST_F(FlatHashMapTest, ReusesDeletedSlots) {
+  FlatHashMap<Key, int> map;
+  for (int i = 0; i < 100000; ++i) {
+    auto key = randomKey();
+    map.try_emplace(key, i);
+    map.erase(key);
+  }
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.capacity(), 16);
+}
+
+/**
+ * @given keys with equal first 8 bytes
+ * @when insert them into set
+ * @then they are distinguished by full comparison
+ */
+TEST_F(FlatHashMapTest, CollidingKeys) {
+  FlatHashSet<Key> set;
+  auto base = randomKey();
+  for (uint8_t i = 0; i < 100; ++i) {
+    auto key = base;
+    key[31] = i;
+    EXPECT_TRUE(set.insert(key).second);
+    EXPECT_FALSE(set.insert(key).second);
+  }
+  EXPECT_EQ(set.size(), 100);
+  for (uint8_t i = 0; i < 100; ++i) {
+    auto key = base;
+    key[31] = i;
+    EXPECT_TRUE(set.contains(key));
+  }
+}
+
+/**
+ * @given map allocating from monotonic arena
+ * @when copy and move it
+ * @then copies are independent and moved-from map is empty
+ */
+TEST_F(FlatHashMapTest, CopyMoveWithMemoryResource) {
+  std::pmr::monotonic_buffer_resource arena;
+  jam::pmr::FlatHashMap<Key, int> map{&arena};
+  for (int i = 0; i < 100; ++i) {
+    map[randomKey()] = i;
+  }
+  auto copy = map;
+  EXPECT_EQ(copy.size(), 100);
+  auto moved = std::move(map);
+  EXPECT_EQ(moved.size(), 100);
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(moved.get_allocator().resource(), &arena);
+  for (auto &[key, value] : copy) {
+    EXPECT_EQ(moved.at(key), value);
+  }
+}
+
+/**
+ * @given sets allocating from different memory resources
+ * @when iterate set, and move-assign it to set of another resource
+ * @then keys are immutable through iterators, and are moved one by one
+ */
+TEST_F(FlatHashMapTest, SetKeysAreConst) {
+  using Set = jam::pmr::FlatHashSet<Key>;
+  static_assert(std::is_same_v<decltype(*std::declval<Set::iterator>()),
+                               const Key &>);
+  static_assert(
+      std::is_same_v<decltype(*std::declval<Set::const_iterator>()),
+                     const Key &>);
+
+  std::pmr::monotonic_buffer_resource arena1;
+  std::pmr::monotonic_buffer_resource arena2;
+  Set set{&arena1};
+  std::vector<Key> keys;
+  for (int i = 0; i < 100; ++i) {
+    keys.emplace_back(randomKey());
+    set.insert(keys.back());
+  }
+  Set moved{&arena2};
+  moved = std::move(set);
+  EXPECT_TRUE(set.empty());
+  EXPECT_EQ(moved.get_allocator().resource(), &arena2);
+  EXPECT_EQ(moved.size(), keys.size());
+  for (auto &key : keys) {
+    EXPECT_TRUE(moved.contains(key));
+  }
+}